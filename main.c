@@ -24,27 +24,122 @@ Brett Harley A. Mider, DLSU ID# 12117601
 **************************************************************************************************/
 
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// the text is scanned a block of bytes at a time where the compiler allows
+// it (e.g. -mavx2 or -march=native for AVX2; SSE2 is always there on
+// x86-64), and a byte at a time if not
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SCAN_WIDTH 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SCAN_WIDTH 16
+#endif
 
-#define MAX_ENTRIES  150
-#define MAX_COUNT    10
 #define MIN_LANG_LEN 1
-#define MAX_LANG_LEN 20
 #define MIN_TL_LEN   1
-#define MAX_TL_LEN   20
 #define MIN_FILE_LEN 5
 #define MAX_FILE_LEN 30
 #define MAX_TEXT_LEN 150
 
-#define STR20LEN  21
 #define STR30LEN  31
 #define STR35LEN  36
 #define STR150LEN 151
 #define STR175LEN 176
 
+#define INDEX_MIN_BUCKETS 64
+#define STORE_MIN_CAPACITY 16
+#define PHRASE_MIN_SLOTS  64
+#define STRINGS_MIN_SLOTS 64
+#define GRAPH_MAX_LANGS   1024
+#define TABLE_BUDGET      (64 << 20)
+#define MAX_TABLE_MB      (1 << 20)
+#define CHARS_PER_LOOKUP  4
+#define MEMORY_LINES      4096
+#define MEMORY_MAX_LINE   1024
+#define MEMORY_MISS_RUN   64
+#define MEMORY_SKIP_LINES 1024
+#define MAX_SPAN_LEN      256
+#define TEXT_MIN_CAPACITY 256
+#define FILE_CHUNK_SIZE   (1 << 20)
+#define BATCH_CHUNK_SIZE  (1 << 20)
+#define MAX_THREADS       64
+#define IMPORT_CHUNK_SIZE (1 << 20)
+#define EXPORT_BUFFER_SIZE (1 << 20)
+
+#define DEFAULT_FIRST_LANG "English"
+
+// how the entries of a file are imported (see loadEntries())
+#define IMPORT_ASK        1
+#define IMPORT_ACCEPT_ALL 2
+#define IMPORT_SKIP       3
+#define IMPORT_MERGE      4
+#define IMPORT_REPLACE    5
+
+// what a line of a dictionary file is (see parsePairLine())
+#define LINE_OTHER 0
+#define LINE_PAIR  1
+
+#define SNAP_MAGIC      "SLTSNAP"
+#define SNAP_VERSION    5
+#define SNAP_BYTE_ORDER 0x01020304u
+#define SNAP_ALIGN      64
+#define SNAP_EXT        ".snap"
+
+// sections of a snapshot file, in the order they are written
+#define SNAP_META          0
+#define SNAP_ENTRIES       1
+#define SNAP_SRC_KEYS      2
+#define SNAP_PAIRS         3
+#define SNAP_LANG_NAMES    4
+#define SNAP_LANG_IDS      5
+#define SNAP_LANG_SLOTS    6
+#define SNAP_INDEX_HEADS   7
+#define SNAP_INDEX_NEXT    8
+#define SNAP_WORDS         9
+#define SNAP_POSTINGS      10
+#define SNAP_PHRASE_NODES  11
+#define SNAP_PHRASE_SLOTS  12
+#define SNAP_PHRASE_WORDS  13
+#define SNAP_PHRASE_WORD_IDS   14
+#define SNAP_PHRASE_WORD_SLOTS 15
+#define SNAP_STRINGS       16
+#define SNAP_STRING_IDS    17
+#define SNAP_STRING_SLOTS  18
+#define SNAP_FIRST_LANG    19
+#define SNAP_SECTIONS      20
+
+// the journal of changes that follows a snapshot (see openJournal())
+#define JOURNAL_MAGIC           "SLTJRNL"
+#define JOURNAL_VERSION         3
+#define JOURNAL_EXT             ".journal"
+#define JOURNAL_BATCH_SIZE      (16 << 10)
+#define JOURNAL_COMPACT_RECORDS 100000
+
+// the changes recorded in a journal (see recordChange())
+#define JOURNAL_NEW_ENTRY    1
+#define JOURNAL_ADD_PAIR     2
+#define JOURNAL_INDEX_ENTRY  3
+#define JOURNAL_DELETE_ENTRY 4
+#define JOURNAL_DELETE_PAIR  5
+#define JOURNAL_ARRANGE      6
+#define JOURNAL_DROP_LAST    7
+#define JOURNAL_REPLACE      8
+#define JOURNAL_EMPTY        9
+#define JOURNAL_FIRST_LANG   10
+#define JOURNAL_COMPACT      11
+
 #define CONFIRM_YES 'y'
 #define CONFIRM_NO  'n'
 
@@ -52,21 +147,443 @@ Brett Harley A. Mider, DLSU ID# 12117601
 #define ENTRY_OPTION_PREV 'P'
 #define ENTRY_OPTION_EXIT 'X'
 
-// for language and translation strings and the text to be translated
-typedef char String20[STR20LEN];
+// for file names and the text to be translated
 typedef char String30[STR30LEN];
 typedef char String35[STR35LEN];
 typedef char String150[STR150LEN];
 typedef char String175[STR175LEN];
 
-// for each entry in the machine translator
+// for each language-translation pair, where the language is the ID of its
+// name in the language table of the dictionary
+typedef struct pair
+{
+    int lang;  // ID of the language
+    int trans; // ID of the translation in the string pool
+    int len;   // length of the translation
+} Pair;
+
+// for the densely packed "hot" copy of the "source" pair of each entry, so
+// that scans over the "source" pairs of all entries only touch this array
+typedef struct sourceKey
+{
+    int lang;   // language ID of the "source" pair (-1 if none yet)
+    int trans;  // string ID of the translation of the "source" pair
+    int offset; // index of the "source" pair in the pair pool
+} SourceKey;
+
+// for the characters of all the translations (or language names) of a
+// dictionary, where each distinct string is stored once and followed by
+// '\0', and is known by a small integer ID so equal strings can be compared
+// as integers; the length of a string is where the next one starts
+typedef struct stringPool
+{
+    char *data;    // the characters of all the strings
+    int nUsed;     // amount of characters used
+    int nCap;      // amount of characters data can hold
+    int *offsets;  // offset of each string in data, indexed by ID
+    int nStrings;  // amount of distinct strings
+    int nIdCap;    // amount of offsets the offsets array can hold
+    int *slots;    // open addressing hash table of IDs (-1 if empty)
+    int nSlots;    // amount of slots (always a power of 2)
+    int nMaxLen;   // length of the longest string
+} StringPool;
+
+// for each entry in the machine translator, whose pairs are stored
+// contiguously in the pair pool of the dictionary
 typedef struct entry
 {
-    String20 lang[MAX_COUNT];
-    String20 trans[MAX_COUNT];
-    int count;
+    int offset;   // index of the first pair of the entry in the pair pool
+    int count;    // amount of pairs in the entry (0 once deleted)
+    int capacity; // amount of pairs reserved for the entry in the pair pool
 } Entry;
 
+// for the hash index of the "source" language-translation pairs of all
+// entries, where entries in the same bucket are chained through next
+typedef struct wordIndex
+{
+    int *heads;            // first entry in each bucket (-1 if empty)
+    int *next;             // next entry in the same bucket (-1 if none)
+    int nBuckets;          // amount of buckets (always a power of 2)
+    int nSlots;            // amount of entries next can hold
+    int nIndexed;          // amount of entries in the index
+} WordIndex;
+
+// for each location of a translation string in the dictionary
+typedef struct posting
+{
+    int entry; // index of the entry
+    int pair;  // index of the pair within the entry
+} Posting;
+
+// for each distinct translation string, whose locations are stored
+// contiguously in the posting pool, sorted by entry and then by pair
+typedef struct wordPostings
+{
+    int offset;         // index of the first location in the posting pool
+    int count;          // amount of locations
+    int capacity;       // amount of locations reserved in the posting pool
+} WordPostings;
+
+// for the inverted index from every translation string (of the indexed
+// entries) to the pairs where it is found
+typedef struct postingIndex
+{
+    WordPostings *words; // locations of each string, by string ID
+    int nWords;          // amount of string IDs the words array covers
+    int nWordCap;        // amount of strings the words array can hold
+    Posting *pool;       // posting pool shared by all the strings
+    int nPool;           // amount of locations used in the posting pool
+    int nPoolCap;        // amount of locations the posting pool can hold
+} PostingIndex;
+
+// for each word of the phrases (translations with spaces in them) of the
+// pairs; the children of a node are the words that can follow it
+typedef struct phraseNode
+{
+    int parent;        // node of the word before it (< -1 for the first)
+    int word;          // ID of the word in the words of the trie
+    int nChildren;     // amount of words that can follow it
+} PhraseNode;
+
+// for the trie of the phrases of every language, whose edges are kept in
+// an open addressing hash table keyed by the parent and the word
+typedef struct phraseTrie
+{
+    PhraseNode *nodes; // all the nodes
+    int nNodes;        // amount of nodes
+    int nNodeCap;      // amount of nodes the nodes array can hold
+    int *slots;        // hash table of nodes (-1 if empty)
+    int nSlots;        // amount of slots (always a power of 2)
+    StringPool words;  // the words of the phrases
+} PhraseTrie;
+
+// for the graph of the languages that are found together in entries, which
+// is used to translate through a pivot language; both tables are nLangs by
+// nLangs, and are only computed again once the dictionary has changed
+typedef struct langGraph
+{
+    int *links;  // amount of times two languages are in the same entry
+    int *pivots; // best pivot between two languages (-1 if none, -2 if
+                 // not computed yet)
+    int nLangs;  // amount of languages the tables cover
+    int isStale; // 1 if the dictionary changed since links was computed
+} LangGraph;
+
+// for the materialized translations from one language to another, which
+// map the string ID of each word straight to the string ID of its
+// translation
+typedef struct pairTable
+{
+    int lang;          // language ID of the words
+    int destLang;      // language ID of the translations
+    int nPivotLang;    // pivot language it was computed with (-1 if none)
+    int *arrTrans;     // translation of each string ID (-1 if none, -2 if
+                       // it must be computed again)
+    int nIds;          // amount of string IDs arrTrans covers
+    int nIdCap;        // amount of string IDs arrTrans can hold
+    int nStale;        // amount of string IDs that are -2
+    int isStale;       // 1 if the whole table must be computed again
+    size_t nLookups;   // words looked up without the table since it was
+                       // last brought up to date
+    unsigned int nLastUse; // when the table was last used (see nClock)
+} PairTable;
+
+// for the materialized translations of the language pairs that are used,
+// which are kept within a memory budget by dropping the least recently
+// used table
+typedef struct tableCache
+{
+    PairTable *tables; // the tables, in no particular order
+    int nTables;       // amount of tables
+    int nTableCap;     // amount of tables the tables array can hold
+    size_t nBudget;    // most bytes the translations of all tables can use
+    size_t nUsed;      // bytes used by the translations of all tables
+    unsigned int nClock; // counts the uses of the tables
+    int nPaused;       // tables are not marked while this is above 0
+} TableCache;
+
+// for a line that was translated before, kept in the translation memory
+typedef struct memoryLine
+{
+    unsigned int hash; // hash of the languages and the words of the line
+    int lang;          // language ID of the line
+    int destLang;      // language ID of the translation
+    int isExact;       // 1 if the words are the line as it is (see
+                       // keepsFormat), 0 if they are normalized
+    char *words;       // the words of the line without their symbols,
+                       // separated by single spaces (or the line as it is),
+                       // then the translation
+    int nWordsLen;     // amount of characters of the words
+    int nTransLen;     // amount of characters of the translation
+    int nNext;         // next line in the same bucket (-1 if none)
+    int nNewer;        // line used right after this one (-1 if none)
+    int nOlder;        // line used right before this one (-1 if none)
+} MemoryLine;
+
+// for the translations of the most recently used lines, so a line that is
+// repeated is not translated word by word again; the lines are chained in
+// buckets by hash, and kept in order of use to drop the oldest one
+typedef struct transMemory
+{
+    MemoryLine *lines; // the lines, in no particular order
+    int nLines;        // amount of lines
+    int nLineCap;      // amount of lines the lines array can hold
+    int nMaxLines;     // most lines kept (0 to keep none)
+    int *buckets;      // first line with each hash (-1 if none)
+    int nBuckets;      // amount of buckets (a power of 2)
+    int nNewest;       // most recently used line (-1 if none)
+    int nOldest;       // least recently used line (-1 if none)
+    unsigned long nHits;   // amount of lines found in the memory
+    unsigned long nMisses; // amount of lines translated word by word
+} TransMemory;
+
+// for all the data of the machine translator; both arrays grow as needed
+typedef struct dictionary
+{
+    Entry *entries;      // all the entries
+    SourceKey *srcKeys;  // "source" key of each entry, parallel to entries
+    int nEntries;        // amount of entries (including deleted ones)
+    int nDeleted;        // amount of deleted entries not compacted yet
+    int nEntryCap;       // amount of entries both arrays can hold
+    Pair *pairs;         // pair pool shared by all the entries
+    int nPairs;          // amount of pairs used in the pair pool
+    int nPairCap;        // amount of pairs the pair pool can hold
+    StringPool langs;    // names of the languages used by the pairs, whose
+                         // string IDs are the language IDs
+    StringPool strings;  // translations of the pairs
+    WordIndex index;     // hash index of the "source" pairs
+    PostingIndex postings; // inverted index of all the pairs
+    PhraseTrie phrases;  // words of the pairs with several words
+    LangGraph graph;     // languages found together, for pivot translation
+    TableCache tables;   // translations of the language pairs in use
+    TransMemory memory;  // translations of the lines used most recently
+    int *order;          // scratch permutation used to arrange the entries
+    int nOrderCap;       // amount of indices the order array can hold
+    int *live;           // index of each entry that is not deleted, in
+                         // order, so they can be numbered without the
+                         // deleted ones (only kept while some are deleted)
+    int nLiveCap;        // amount of indices the live array can hold
+    int isNumbered;      // 1 if live is up to date with the entries
+    char *firstLang;     // entries with this language are arranged first
+    int isArranged;      // 1 if nothing changed since the last arrangement
+    char *mapped;        // snapshot the arrays point into (NULL if none)
+    size_t nMapped;      // size of the mapped snapshot
+    struct exportJob *exporting; // export in the background (NULL if none)
+    struct journal *journal;     // journal of the changes (NULL if none)
+    unsigned int nGeneration;    // amount of times the journal was compacted
+} Dictionary;
+
+// for how much an export wrote and how long it took
+typedef struct exportStats
+{
+    long nPairs;    // amount of pairs written
+    size_t nBytes;  // amount of characters written
+    double seconds; // time it took
+} ExportStats;
+
+// for an export that runs on a thread of its own (see startExport())
+typedef struct exportJob
+{
+    Dictionary *dict;      // the dictionary (only read by the thread)
+    String30 filename;     // the name of the text file
+    ExportStats stats;     // how much was written and how long it took
+    int isWritten;         // 1 if the file was written
+    int isDone;            // 1 once the thread is done
+    int isJoined;          // 1 once the thread has been waited for
+    pthread_t thread;      // the thread
+    pthread_mutex_t lock;  // guards isDone
+} ExportJob;
+
+// for the amount of entries of a file that were imported in each way
+typedef struct importStats
+{
+    int nAdded;    // added as new entries
+    int nSkipped;  // left out
+    int nMerged;   // whose pairs were added to an existing entry
+    int nReplaced; // that took the place of an existing entry
+} ImportStats;
+
+// for the settings of a dictionary that are stored in a snapshot
+typedef struct snapMeta
+{
+    int isArranged;     // 1 if the entries were arranged when written
+    unsigned int nGeneration; // generation of the journal that follows it
+    int nMaxLangLen;    // length of the longest language name
+    int nMaxWordLen;    // length of the longest word of the phrase trie
+    int nMaxLen;        // length of the longest translation
+} SnapMeta;
+
+// for the location of an array of the dictionary in a snapshot file
+typedef struct snapSection
+{
+    unsigned int id;           // which array it is (SNAP_META and so on)
+    unsigned int elemSize;     // size of each element of the array
+    unsigned long long offset; // where the array starts in the file
+    unsigned long long count;  // amount of elements in the array
+} SnapSection;
+
+// for the start of a snapshot file, which is followed by its sections
+typedef struct snapHeader
+{
+    char magic[8];             // always SNAP_MAGIC
+    unsigned int version;      // format of the file (SNAP_VERSION)
+    unsigned int byteOrder;    // SNAP_BYTE_ORDER as written by the machine
+    unsigned int nSections;    // always SNAP_SECTIONS
+    unsigned int reserved;     // always 0
+    SnapSection sections[SNAP_SECTIONS];
+} SnapHeader;
+
+// for a change to a dictionary as it is stored in a journal file, where it
+// is followed by the characters of its language and then of its translation
+typedef struct journalRecord
+{
+    int op;             // which change it is (JOURNAL_NEW_ENTRY and so on)
+    int arg1;           // first argument of the change (0 if none)
+    int arg2;           // second argument of the change (0 if none)
+    int nLangLen;       // length of the language of the change (0 if none)
+    int nTransLen;      // length of the translation of the change (0 if
+                        // none)
+    unsigned int check; // hash of the record with check set to 0, followed
+                        // by its language and translation
+} JournalRecord;
+
+// for the start of a journal file, which is followed by its records
+typedef struct journalHeader
+{
+    char magic[8];            // always JOURNAL_MAGIC
+    unsigned int version;     // format of the file (JOURNAL_VERSION)
+    unsigned int nGeneration; // generation of the snapshot it follows
+} JournalHeader;
+
+// for the journal of a persistent dictionary (see openJournal())
+typedef struct journal
+{
+    char *snapName;     // the snapshot the journal follows
+    char *journalName;  // the journal file
+    int fd;             // the journal file, opened for appending
+    char *pending;      // records not written yet, one after the other
+    int nPending;       // amount of characters not written yet
+    int nPendingCap;    // amount of characters pending can hold
+    long nRecords;      // amount of records since the last compaction
+    int nPaused;        // changes are not recorded while this is > 0
+} Journal;
+
+// for text that grows as it is written, such as a translated document
+typedef struct textBuf
+{
+    char *data; // the characters of the text (not null-terminated)
+    size_t len; // amount of characters in the text
+    size_t cap; // amount of characters data can hold
+} TextBuf;
+
+// for a word found at the start of some text (see scanWord())
+typedef struct wordScan
+{
+    size_t len;    // amount of characters in the word, with its symbols
+    size_t nLead;  // start of the word without its leading symbols
+    size_t nTail;  // end of the word without its trailing symbols
+    size_t nClean; // amount of characters in the word that are not symbols
+    unsigned int hash; // hash of the word without its symbols (see
+                       // scanKey())
+} WordScan;
+
+// for where a queued word is in the queue of a translator, and in its
+// pending text if it keeps the symbols and spacing of the text
+typedef struct wordSpan
+{
+    int nKeyEnd; // end of the word (without its symbols) in the queue
+    unsigned int hash; // hash of the word without its symbols
+    int nStart;  // start of the word, with its leading symbols
+    int nCore;   // start of the word without its leading symbols
+    int nTail;   // end of the word without its trailing symbols
+    int nEnd;    // end of the separators after the word
+} WordSpan;
+
+// for translating text from one language to another, possibly in parts
+typedef struct translator
+{
+    Dictionary *dict; // the dictionary used to translate
+    TransMemory *memory; // the translation memory used for whole lines
+    int nSourceLang;  // ID of the language of the text (-1 if unknown)
+    int nDestLang;    // ID of the language to translate to (-1 if unknown)
+    int nPivotLang;   // ID of the language to translate through (-1 if none)
+    int *arrTable;    // translation of each string ID (NULL if no table)
+    int keepsFormat;  // 1 if the symbols and spacing of the text are kept
+    int nMaxLen;      // length of the longest translation, beyond which a
+                      // word cannot have one
+    int nMaxSpan;     // most characters kept in held and pending
+    int hasWord;      // 1 if a word was written on the current line
+    TextBuf held;     // start of a word that continues in the next text
+    int isWordOut;    // 1 if the continuing word is too long to translate
+    TextBuf queue;    // words that may start a phrase, without their
+                      // symbols and separated by single spaces
+    int nQueued;      // amount of words in the queue
+    TextBuf pending;  // queued words as they are in the text, with the
+                      // separators after them
+    WordSpan *spans;  // where each queued word is in queue and pending
+    int nSpanCap;     // amount of words the spans array can hold
+    int nMissRun;     // lines in a row not found in the translation memory
+    int nSkipLines;   // lines to translate without the translation memory
+} Translator;
+
+// for a part of a document that is translated by one of the worker threads
+typedef struct batchChunk
+{
+    char *text;  // the lines of the part (not null-terminated)
+    size_t len;  // amount of characters in the part
+    TextBuf out; // the translation of the part
+    int isDone;  // 1 once the part has been translated
+} BatchChunk;
+
+// for the work shared by the worker threads of the batch mode
+typedef struct batchJob
+{
+    Translator start;      // the translator each part starts from (its
+                           // dictionary is only read by the threads)
+    BatchChunk *chunks;    // the parts of the document, in order
+    int nChunks;           // amount of parts
+    int nNext;             // the next part that no thread has taken yet
+    pthread_mutex_t lock;  // guards nNext and the isDone of each part
+    pthread_cond_t done;   // signalled whenever a part is done
+} BatchJob;
+
+// for each line of a dictionary file that is parsed by a worker thread
+typedef struct parsedLine
+{
+    int nKind;  // LINE_PAIR or LINE_OTHER (which ends an entry)
+    int lang;   // offset of the language in the strings of its part (only
+                // for LINE_PAIR)
+    int trans;  // offset of the translation in the strings of its part
+                // (only for LINE_PAIR)
+} ParsedLine;
+
+// for each part of a dictionary file that is parsed by a worker thread
+typedef struct importChunk
+{
+    char *text;         // the lines of the part (not null-terminated)
+    size_t len;         // amount of characters in the part
+    ParsedLine *lines;  // the parsed lines of the part
+    int nLines;         // amount of parsed lines
+    int nLineCap;       // amount of lines the lines array can hold
+    char *strings;      // the languages and translations of the lines,
+                        // each followed by '\0'
+    int nUsed;          // amount of characters used in strings
+    int nStringCap;     // amount of characters strings can hold
+    int isDone;         // 1 once the part has been parsed
+} ImportChunk;
+
+// for the work shared by the worker threads of a parallel import
+typedef struct importJob
+{
+    ImportChunk *chunks;   // the parts of the file, in order
+    int nChunks;           // amount of parts
+    int nNext;             // the next part that no thread has taken yet
+    int nAdded;            // amount of parts added to the dictionary
+    int nWindow;           // how far parsing may get ahead of adding
+    pthread_mutex_t lock;  // guards the counts and the isDone of each part
+    pthread_cond_t done;   // signalled whenever a part is parsed or added
+} ImportJob;
+
 /**
  * @brief
  *    Removes the first instance of a newline character in a string.
@@ -117,6 +634,57 @@ titleCase(char *str)
     }
 }
 
+/**
+ * @brief
+ *    Converts the uppercase letters (A to Z) of a block of text to
+ *    lowercase in place, a block of bytes at a time where possible.
+ *
+ * @param text   The characters to be converted (not null-terminated).
+ * @param len    The amount of characters.
+ */
+void
+foldCase(char *text,
+         size_t len)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i block, isUpper;
+
+    // bytes from 'A' to 'Z' get the 0x20 bit of their lowercase letter
+    for (; i + SCAN_WIDTH <= len; i += SCAN_WIDTH)
+    {
+        block = _mm256_loadu_si256((__m256i *)&text[i]);
+        isUpper = _mm256_and_si256(
+            _mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+        block = _mm256_or_si256(block, _mm256_and_si256(isUpper,
+                                                     _mm256_set1_epi8(0x20)));
+        _mm256_storeu_si256((__m256i *)&text[i], block);
+    }
+#elif defined(__SSE2__)
+    __m128i block, isUpper;
+
+    // bytes from 'A' to 'Z' get the 0x20 bit of their lowercase letter
+    for (; i + SCAN_WIDTH <= len; i += SCAN_WIDTH)
+    {
+        block = _mm_loadu_si128((__m128i *)&text[i]);
+        isUpper = _mm_and_si128(_mm_cmpgt_epi8(block,
+                                               _mm_set1_epi8('A' - 1)),
+                                _mm_cmplt_epi8(block,
+                                               _mm_set1_epi8('Z' + 1)));
+        block = _mm_or_si128(block, _mm_and_si128(isUpper,
+                                                  _mm_set1_epi8(0x20)));
+        _mm_storeu_si128((__m128i *)&text[i], block);
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        if (text[i] >= 'A' && text[i] <= 'Z')
+            text[i] += 'a' - 'A';
+    }
+}
+
 /**
  * @brief Converts a string to lowercase. this is lowercase.
  *
@@ -125,12 +693,7 @@ titleCase(char *str)
 void
 lowercase(char *str)
 {
-    int i = 0;
-    while (str[i] != '\0')
-    {
-        str[i] = tolower(str[i]);
-        i++;
-    }
+    foldCase(str, strlen(str));
 }
 
 /**
@@ -196,6 +759,84 @@ getStrInput(char *str,
     free(tempStr);
 }
 
+/**
+ * @brief
+ *    Gets a string of any length from the user, with a set minimum amount
+ *    of characters.
+ *
+ * @details
+ *    The function getline() reads the whole line into a buffer that grows
+ *    as needed, so nothing the user enters is cut short.
+ *
+ * @param minStrLen   The minimum amount of characters of the desired input.
+ *
+ * @pre   minStrLen is >= 0.
+ *
+ * @return Returns the string input, which must be freed by the caller.
+ */
+char *
+getLineInput(int minStrLen)
+{
+    char *str = NULL;
+    size_t nCap = 0;
+    int inputIsValid = 0;
+    int len = 0;
+
+    while (!inputIsValid)
+    {
+        printf("Input: ");
+        if (getline(&str, &nCap, stdin) == -1)
+        {
+            printf("\nNo more input! Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+
+        removeNewline(str);
+
+        len = strlen(str);
+        if (len >= minStrLen)
+        {
+            inputIsValid = 1;
+        }
+        else
+        {
+            printf("\nYour input must be at least %d character%s!\n",
+                   minStrLen, minStrLen == 1 ? "" : "s");
+        }
+    }
+
+    return str;
+}
+
+/**
+ * @brief Copies a string of a given length into memory of its own.
+ *
+ * @param str   The characters of the string (not necessarily
+ *              null-terminated).
+ * @param len   The amount of characters.
+ *
+ * @return
+ *    The null-terminated copy of the string, which must be freed by the
+ *    caller.
+ */
+char *
+copyString(char *str,
+           size_t len)
+{
+    char *copy = (char *)malloc(len + 1);
+
+    if (copy == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+
+    return copy;
+}
+
 /**
  * @brief Gets an int from the user.
  *
@@ -250,2065 +891,8783 @@ getCharInput()
 }
 
 /**
- * @brief Copies a lang-tl pair to another.
+ * @brief
+ *    Makes sure that an array can hold at least nNeeded elements. If it
+ *    cannot, its capacity is doubled until it can (geometric growth), so that
+ *    adding elements one at a time takes constant time on average.
  *
- * @param destLang   Destination string for the language.
- * @param destTL     Destination string for the translation.
- * @param srcLang    Source string for the language.
- * @param srcTL      Source string for the translation.
+ * @param arr         The array to be grown (may be NULL if empty).
+ * @param pCapacity   The address of the amount of elements the array can
+ *                    hold, which is updated if the array is grown.
+ * @param nNeeded     The amount of elements the array must be able to hold.
+ * @param elemSize    The size of each element of the array.
+ *
+ * @return Returns the (possibly moved) array.
  */
-void
-copyLangTLPair(char *destLang, 
-               char *destTL, 
-               char *srcLang, 
-               char *srcTL)
+void *
+growArray(void *arr,
+          int *pCapacity,
+          int nNeeded,
+          size_t elemSize)
 {
-    strncpy(destLang, srcLang, MAX_LANG_LEN + 1);
-    strncpy(destTL, srcTL, MAX_TL_LEN + 1);
+    int newCapacity = *pCapacity;
+
+    if (nNeeded > *pCapacity)
+    {
+        if (newCapacity < STORE_MIN_CAPACITY)
+            newCapacity = STORE_MIN_CAPACITY;
+
+        while (newCapacity < nNeeded)
+        {
+            // avoid overflowing the int capacity for huge arrays
+            if (newCapacity > INT_MAX / 2)
+                newCapacity = INT_MAX;
+            else
+                newCapacity *= 2;
+        }
+
+        arr = realloc(arr, (size_t)newCapacity * elemSize);
+        if (arr == NULL)
+        {
+            printf("Out of memory! Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+
+        *pCapacity = newCapacity;
+    }
+
+    return arr;
 }
 
 /**
- * @brief Clears a lang-tl pair (sets both to null strings).
+ * @brief Returns a language-translation pair of an entry.
  *
- * @param lang   Language string to be cleared.
- * @param tl     Translation string to be cleared.
+ * @param dict     The dictionary containing the entry.
+ * @param nEntry   The index of the entry.
+ * @param nPair    The index of the pair within the entry.
+ *
+ * @pre   nEntry is >= 0 and <= dict->nEntries - 1.
+ * @pre   nPair is >= 0 and <= the amount of pairs reserved for the entry - 1.
+ *
+ * @return
+ *    The address of the pair. It is only valid until the next pair is added
+ *    to the dictionary, since the pair pool may be moved when it grows.
  */
-void
-clearLangTLPair(char *lang, 
-                char *tl)
+Pair *
+getPair(Dictionary *dict,
+        int nEntry,
+        int nPair)
 {
-    strcpy(lang, "");
-    strcpy(tl, "");
+    return &dict->pairs[dict->entries[nEntry].offset + nPair];
 }
 
 /**
- * @brief
- *    Clears an entry (sets all lang-tl pairs to null strings and sets count
- *    to 0).
+ * @brief Computes the hash of a block of bytes using the FNV-1a algorithm.
+ *
+ * @details
+ *    Reference: http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ *
+ * @param data   The bytes to be hashed.
+ * @param len    The amount of bytes.
+ * @param hash   The initial value of the hash (2166136261 for a new hash).
  *
- * @param givenEntry   Entry to be cleared.
+ * @return Returns the hash of the bytes.
  */
-void
-clearEntry(Entry *givenEntry)
+unsigned int
+hashBytes(char *data,
+          size_t len,
+          unsigned int hash)
 {
-    Entry temp = {};
-    *givenEntry = temp;
-}
+    size_t i;
 
-/**
- * @brief
- *    This function displays the divider for better readability in the
- *    runtime.
- */
-void
-displayDivider()
-{
-    printf("\n");
-    for (int i = 0; i < 100; i++)
+    for (i = 0; i < len; i++)
     {
-        printf("-");
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
     }
-    printf("\n\n");
+
+    return hash;
 }
 
 /**
- * @brief This function displays the Main Menu to the user.
+ * @brief
+ *    Computes the hash of a lang-tl pair by mixing the ID of the language
+ *    into the hash of the translation.
+ *
+ * @param lang       The language ID of the pair.
+ * @param wordHash   The hash of the translation of the pair (see
+ *                   hashBytes()), or its string ID.
  *
+ * @return Returns the hash of the lang-tl pair.
  */
-void
-displayMainMenu()
+unsigned int
+hashLangTLPair(int lang,
+               unsigned int wordHash)
 {
-    displayDivider();
-
-    char menuText[] = "MAIN MENU\n"
-                      "1 - Manage Data\n"
-                      "2 - Translate Menu\n"
-                      "3 - Exit";
-
-    printf("%s", menuText);
+    return (wordHash ^ (unsigned int)lang) * 16777619u;
 }
 
 /**
- * @brief This function displays the Translate Menu to the user.
+ * @brief Initializes an empty string pool.
  *
+ * @param pool   The string pool to be initialized.
  */
 void
-displayTransMenu()
+initStrings(StringPool *pool)
 {
-    displayDivider();
-
-    char menuText[] = "TRANSLATE MENU\n"
-                      "1 - Translate\n"
-                      "2 - Exit";
+    int i;
 
-    printf("%s", menuText);
+    pool->data = NULL;
+    pool->nUsed = 0;
+    pool->nCap = 0;
+    pool->offsets = NULL;
+    pool->nStrings = 0;
+    pool->nIdCap = 0;
+    pool->nMaxLen = 0;
+    pool->nSlots = STRINGS_MIN_SLOTS;
+    pool->slots = (int *)malloc(pool->nSlots * sizeof(int));
+    for (i = 0; i < pool->nSlots; i++)
+    {
+        pool->slots[i] = -1;
+    }
 }
 
 /**
  * @brief
- *    This function asks the user to choose from the given choices of the
- *    Main Menu.
+ *    Removes all strings from a string pool by rewinding it to its start.
+ *    The memory of the pool is kept so it can be reused.
  *
- * @param pMainChoice   The address where the user's choice will be stored.
+ * @param pool   The string pool to be cleared.
  */
 void
-getMainChoice(int *pMainChoice)
+clearStrings(StringPool *pool)
 {
-    printf("\n\nEnter a number from 1 to 3.\n");
-    *pMainChoice = getIntInput(1, 3);
+    int i;
+
+    for (i = 0; i < pool->nSlots; i++)
+    {
+        pool->slots[i] = -1;
+    }
+
+    pool->nUsed = 0;
+    pool->nStrings = 0;
+    pool->nMaxLen = 0;
 }
 
 /**
- * @brief
- *    This function asks the user to choose from the given choices of the
- *    Translate Menu.
+ * @brief Frees the memory used by a string pool.
  *
- * @param pTransChoice   The address where the user's choice will be stored.
+ * @param pool   The string pool to be freed.
  */
 void
-getTransChoice(int *pTransChoice)
+freeStrings(StringPool *pool)
 {
-    printf("\n\nEnter a number from 1 to 2.\n");
-    *pTransChoice = getIntInput(1, 2);
+    free(pool->data);
+    free(pool->offsets);
+    free(pool->slots);
 }
 
 /**
- * @brief This function displays the Manage Data Menu to the user.
+ * @brief Returns the length of a string of the string pool.
  *
+ * @param pool   The string pool containing the string.
+ * @param nId    The ID of the string.
+ *
+ * @return Returns the amount of characters in the string.
  */
-void
-displayManageMenu()
+int
+getStringLen(StringPool *pool,
+             int nId)
 {
-    displayDivider();
-
-    char menuText[] = "MANAGE DATA MENU\n"
-                      "1 - Add Entry\t\t\t6 - Search Word\n"
-                      "2 - Add Translation\t\t7 - Search Translation\n"
-                      "3 - Delete Entry\t\t8 - Export\n"
-                      "4 - Delete Translation\t\t9 - Import\n"
-                      "5 - Display All Entries\t\t10 - Exit";
+    int nEnd = nId + 1 < pool->nStrings ? pool->offsets[nId + 1] :
+                                          pool->nUsed;
 
-    printf("%s", menuText);
+    return nEnd - pool->offsets[nId] - 1;
 }
 
 /**
  * @brief
- *     This function asks the user to choose from the given choices of the
- *     Manage Data Menu.
+ *    Returns the slot of the string pool where a string is, or where it
+ *    should be added if it is not in the pool yet.
  *
- * @param pManageChoice   The address where the user's choice will be stored.
+ * @param pool   The string pool to be searched.
+ * @param str    The characters of the string (not necessarily
+ *               null-terminated).
+ * @param len    The amount of characters in the string.
+ * @param hash   The hash of the string (see hashBytes()).
+ *
+ * @return Returns the index of the slot.
  */
-void
-getManageChoice(int *pManageChoice)
+int
+findStringSlot(StringPool *pool,
+               char *str,
+               int len,
+               unsigned int hash)
 {
-    printf("\n\nEnter a number from 1 to 10.\n");
-    *pManageChoice = getIntInput(1, 10);
+    int nSlot = hash & (pool->nSlots - 1);
+    int nId;
+
+    // linear probing until the string or an empty slot is found
+    while ((nId = pool->slots[nSlot]) != -1 &&
+           (getStringLen(pool, nId) != len ||
+            memcmp(&pool->data[pool->offsets[nId]], str, len)))
+    {
+        nSlot = (nSlot + 1) & (pool->nSlots - 1);
+    }
+
+    return nSlot;
 }
 
 /**
  * @brief
- *    This function displays a message to the user, informing them that the
- *    system has already reached the maximum number of entries or pairs in an
- *    entry, depending on the value of nManageChoice.
+ *    Returns the ID of a string in the string pool, adding it to the end of
+ *    the pool first if it is not in the pool yet, so that each distinct
+ *    string is only stored once. IDs are given out in order from 0.
  *
- * @param nManageChoice   The integer representing the user's choice at the
- *  					  Manage Data Menu.
+ * @param pool   The string pool where the string is added.
+ * @param str    The characters of the string (not necessarily
+ *               null-terminated), which can be of any length.
+ * @param len    The amount of characters in the string.
  *
- * @pre   nManageChoice should only contain either 1 or 2.
+ * @return
+ *    The ID of the string. Its address (see getString()) is only valid
+ *    until the next string is added, since the pool may be moved when it
+ *    grows.
  */
-void
-displayMaxMsg(int nManageChoice)
+int
+internString(StringPool *pool,
+             char *str,
+             int len)
 {
-    displayDivider();
-    
-    if (nManageChoice == 1)
-    {
-        printf("The system has already reached the maximum number of ");
-        printf("entries (%d).", MAX_ENTRIES);
-    }
-    else
+    unsigned int hash = hashBytes(str, len, 2166136261u);
+    int nSlot = findStringSlot(pool, str, len, hash);
+    char *old;
+    int i, nOldLen;
+
+    if (pool->slots[nSlot] == -1)
     {
-        printf("This entry has already reached the maximum number of ");
-        printf("pairs (%d).", MAX_COUNT);
+        // keep the table at most half full, rehashing into twice the slots
+        if ((pool->nStrings + 1) * 2 > pool->nSlots)
+        {
+            pool->nSlots *= 2;
+            pool->slots = (int *)realloc(pool->slots,
+                                         pool->nSlots * sizeof(int));
+            for (i = 0; i < pool->nSlots; i++)
+            {
+                pool->slots[i] = -1;
+            }
+
+            for (i = 0; i < pool->nStrings; i++)
+            {
+                old = &pool->data[pool->offsets[i]];
+                nOldLen = getStringLen(pool, i);
+                nSlot = findStringSlot(pool, old, nOldLen,
+                                       hashBytes(old, nOldLen, 2166136261u));
+                pool->slots[nSlot] = i;
+            }
+
+            nSlot = findStringSlot(pool, str, len, hash);
+        }
+
+        pool->data = (char *)growArray(pool->data, &pool->nCap,
+                                       pool->nUsed + len + 1, 1);
+        memcpy(&pool->data[pool->nUsed], str, len);
+        pool->data[pool->nUsed + len] = '\0';
+        pool->offsets = (int *)growArray(pool->offsets, &pool->nIdCap,
+                                         pool->nStrings + 1, sizeof(int));
+        pool->offsets[pool->nStrings] = pool->nUsed;
+        pool->slots[nSlot] = pool->nStrings;
+        pool->nUsed += len + 1;
+        pool->nStrings++;
+        if (len > pool->nMaxLen)
+            pool->nMaxLen = len;
     }
 
-    printf("\nGoing back to the Manage Data Menu now...\n");
+    return pool->slots[nSlot];
 }
 
 /**
  * @brief
- *    This function gets the Language and Translation pair input from the
- *    user. Necessary code to handle invalid inputs were also in place.
+ *    Returns the ID of a string in the string pool without adding it, given
+ *    the hash of the string, so that a string that is looked up in several
+ *    pools (such as a word of a text, see scanKey()) is only hashed once.
  *
- * @param tempLangVar    The string where the translation input is temporarily
- *                       stored.
- * @param tempTransVar   The string where the language input is temporarily
- *                       stored.
+ * @param pool   The string pool to be searched.
+ * @param str    The characters of the string (not necessarily
+ *               null-terminated).
+ * @param len    The amount of characters in the string.
+ * @param hash   The hash of the string (see hashBytes()).
+ *
+ * @return
+ *    The ID of the string   if it is in the pool.
+ *    -1                     if not.
  */
-void
-getLangTrans(String20 tempLangVar, 
-             String20 tempTransVar)
+int
+findHashedString(StringPool *pool,
+                 char *str,
+                 int len,
+                 unsigned int hash)
 {
-    displayDivider();
-
-    // get language
-    printf("Enter language (maximum of 20 characters).\n");
-    getStrInput(tempLangVar, MIN_LANG_LEN, MAX_LANG_LEN + 1);
-    titleCase(tempLangVar);
-
-    // get translation
-    printf("Enter translation (maximum of 20 characters).\n");
-    getStrInput(tempTransVar, MIN_TL_LEN, MAX_TL_LEN + 1);
-    lowercase(tempTransVar);
+    return pool->slots[findStringSlot(pool, str, len, hash)];
 }
 
 /**
  * @brief
- *    This function obtains a command of either next, previous, or exit as the
- *    choice of the user when entries are being displayed.
+ *    Returns the ID of a string in the string pool without adding it, so a
+ *    string can be looked up by hashing it only once and then compared with
+ *    other strings as an integer.
  *
- * @param pDispChoice   The address where the user's command (a char) will be
- *                      stored.
- * @param nIndex        The index of an array.
- * @param nEntryCount   The current number entries in the entry list.
+ * @param pool   The string pool to be searched.
+ * @param str    The characters of the string (not necessarily
+ *               null-terminated).
+ * @param len    The amount of characters in the string.
  *
- * @pre   nIndex is >= 0 and <= nEntryCount - 1.
+ * @return
+ *    The ID of the string   if it is in the pool.
+ *    -1                     if not, in which case no pair has it.
  */
-void
-getDispChoice(char *pDispChoice, 
-              int nIndex, 
-              int nEntryCount)
+int
+findString(StringPool *pool,
+           char *str,
+           int len)
 {
-    // display menu options
-    printf("\n\nYour possible options from here:\n");
-    if (nIndex > 0)
-    {
-        printf("%c - Previous\n", ENTRY_OPTION_PREV);
-    }
-
-    if (nEntryCount > 1 && nIndex <= nEntryCount - 2)
-    {
-        printf("%c - Next\n", ENTRY_OPTION_NEXT);
-    }
-
-    printf("%c - Exit\n", ENTRY_OPTION_EXIT);
+    return findHashedString(pool, str, len, hashBytes(str, len, 2166136261u));
+}
 
-    // get actual choice from user
-    int inputIsValid = 0;
+/**
+ * @brief Returns a string of the string pool.
+ *
+ * @param pool   The string pool containing the string.
+ * @param nId    The ID of the string.
+ *
+ * @return
+ *    The string. It is only valid until the next string is added, since the
+ *    pool may be moved when it grows.
+ */
+char *
+getString(StringPool *pool,
+          int nId)
+{
+    return &pool->data[pool->offsets[nId]];
+}
 
-    while (!inputIsValid)
-    {
-        *pDispChoice = getCharInput();
+/**
+ * @brief Returns the translation of a language-translation pair.
+ *
+ * @param dict   The dictionary containing the pair.
+ * @param pair   The pair.
+ *
+ * @return
+ *    The translation. It is only valid until the next translation is added
+ *    to the dictionary, since the string pool may be moved when it grows.
+ */
+char *
+getTrans(Dictionary *dict,
+         Pair *pair)
+{
+    return getString(&dict->strings, pair->trans);
+}
 
-        // the char obtained is converted to uppercase so it does not
-        // need to be checked with two chars every time
-        *pDispChoice = toupper(*pDispChoice);
+/**
+ * @brief Returns the ID of a language name without adding it to the table.
+ *
+ * @param langs   The language names to be searched.
+ * @param name    The (title case) language name to be found.
+ *
+ * @return
+ *    ID of the language   if the language is in the table.
+ *    -1                   if not.
+ */
+int
+findLang(StringPool *langs,
+         char *name)
+{
+    return findString(langs, name, strlen(name));
+}
 
-        if ((*pDispChoice == ENTRY_OPTION_PREV && nIndex > 0) ||
-            (*pDispChoice == ENTRY_OPTION_NEXT && nEntryCount > 1 &&
-             nIndex <= nEntryCount - 2) ||
-            (*pDispChoice == ENTRY_OPTION_EXIT))
-        {
-            inputIsValid = 1;
-        }
-    }
+/**
+ * @brief
+ *    Returns the ID of a language name, adding it to the language names
+ *    first if it is not there yet.
+ *
+ * @param langs   The language names where the language is interned.
+ * @param name    The (title case) language name to be interned, which can
+ *                be of any length.
+ *
+ * @return Returns the ID of the language.
+ */
+int
+internLang(StringPool *langs,
+           char *name)
+{
+    return internString(langs, name, strlen(name));
 }
 
 /**
- * @brief This function displays one entry to the user.
+ * @brief Returns the name of a language.
  *
- * @param entries         An array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nIndex          The index of an array.
- * @param nManageChoice   The integer representing the user's choice in the
- *                        Manage Data Menu.
+ * @param dict   The dictionary whose language table has the language.
+ * @param lang   The ID of the language.
  *
- * @pre   nIndex should only be an integer ranging from 0 to array size - 1.
+ * @pre   lang is >= 0 and <= dict->langs.nStrings - 1.
+ *
+ * @return Returns the name of the language.
+ */
+char *
+getLangName(Dictionary *dict,
+            int lang)
+{
+    return getString(&dict->langs, lang);
+}
+
+/**
+ * @brief Initializes an empty word index.
+ *
+ * @param index   The word index to be initialized.
  */
 void
-displayCurrent(Entry *entries, 
-               int nIndex, 
-               int nManageChoice)
+initIndex(WordIndex *index)
 {
     int i;
 
-    // display header if displaying entry one at a time
-    if (nManageChoice != 1 && nManageChoice != 2)
-    {
-        displayDivider();
-        printf("Format (Language: Translation)\n");
-    }
-
-    printf("\nEntry No. %d", nIndex + 1);
-
-    // print language-translation pairs
-    for (i = 0; i < entries[nIndex].count; i++)
+    index->nBuckets = INDEX_MIN_BUCKETS;
+    index->heads = (int *)malloc(index->nBuckets * sizeof(int));
+    for (i = 0; i < index->nBuckets; i++)
     {
-        printf("\n(%d) %s: %s", i + 1, entries[nIndex].lang[i],
-                                       entries[nIndex].trans[i]);
+        index->heads[i] = -1;
     }
 
-    printf("\n");
+    index->next = NULL;
+    index->nSlots = 0;
+    index->nIndexed = 0;
 }
 
 /**
- * @brief This function displays to the user all matched entries found.
- *
- * @param entries         An array of structures containing all the entries
- *                        and language-translation pairs.
- * @param arrMatched      The array where the indices of the matched entries
-                          are stored.
- * @param nMatches        The number of matched entries found in the search.
- * @param nManageChoice   The integer representing the user's choice in the
- *                        Manage Data Menu.
+ * @brief Frees the memory used by a word index.
  *
- * @pre   nMatches is >= 1 and <= MAX_ENTRIES.
+ * @param index   The word index to be freed.
  */
 void
-displayMEntries(Entry *entries,
-                int *arrMatched,
-                int nMatches,
-                int nManageChoice)
+freeIndex(WordIndex *index)
 {
-    int i, k = 0;
-    char cDispChoice;
+    free(index->heads);
+    free(index->next);
+}
 
-    displayDivider();
+/**
+ * @brief Removes all entries from a word index.
+ *
+ * @param index   The word index to be cleared.
+ */
+void
+clearIndex(WordIndex *index)
+{
+    int i;
 
-    if (nMatches == 1)
+    for (i = 0; i < index->nBuckets; i++)
     {
-        printf("There is %d matched entry ", nMatches);
-    }
-    else
-    {
-        printf("There are %d matched entries ", nMatches);
+        index->heads[i] = -1;
     }
 
-    printf("that contain%s the ", nMatches == 1 ? "s" : "");
-
-    if (nManageChoice == 1 || nManageChoice == 2 || nManageChoice == 7)
-        printf("language-translation pair.\n");
-    else
-        printf("searched word.\n");
+    index->nIndexed = 0;
+}
 
-    if (nManageChoice == 1 || nManageChoice == 2)
+/**
+ * @brief
+ *    Doubles the amount of buckets of a word index and redistributes the
+ *    indexed entries into the new buckets.
+ *
+ * @param dict   The dictionary whose word index is to be grown.
+ */
+void
+growIndexBuckets(Dictionary *dict)
+{
+    WordIndex *index = &dict->index;
+    SourceKey *key;
+    int *oldHeads = index->heads;
+    int nOldBuckets = index->nBuckets;
+    int i, nEntry, nNext, nBucket;
+
+    index->nBuckets *= 2;
+    index->heads = (int *)malloc(index->nBuckets * sizeof(int));
+    for (i = 0; i < index->nBuckets; i++)
     {
-        displayDivider();
-        printf("Format (Language: Translation)\n");
-        for (i = 0; i < nMatches; i++)
-        {
-            displayCurrent(entries, arrMatched[i], nManageChoice);
-        }
+        index->heads[i] = -1;
     }
-    else
+
+    // move every chained entry into its bucket in the new table
+    for (i = 0; i < nOldBuckets; i++)
     {
-        while (k >= 0 && k < nMatches)
+        nEntry = oldHeads[i];
+        while (nEntry != -1)
         {
-            displayCurrent(entries, arrMatched[k], nManageChoice);
-            getDispChoice(&cDispChoice, k, nMatches);
-
-            switch (cDispChoice)
-            {
-                case ENTRY_OPTION_NEXT:
-                    k++;
-                    break;
-                case ENTRY_OPTION_PREV:
-                    k--;
-                    break;
-                default:
-                    k = nMatches;
-                    break; // exit
-            }
+            nNext = index->next[nEntry];
+            key = &dict->srcKeys[nEntry];
+            nBucket = hashLangTLPair(key->lang, (unsigned int)key->trans) &
+                      (index->nBuckets - 1);
+            index->next[nEntry] = index->heads[nBucket];
+            index->heads[nBucket] = nEntry;
+            nEntry = nNext;
         }
     }
+
+    free(oldHeads);
 }
 
 /**
- * @brief Asks confirmation from the user.
+ * @brief Initializes an empty posting index.
  *
- * @return
- *    1   if the user answers 'yes'.
- *    0   if the user answers 'no'.
+ * @param postings   The posting index to be initialized.
  */
-int
-getUserConfirmation()
+void
+initPostings(PostingIndex *postings)
 {
-    int confirm = 0;
-    int inputIsValid = 0;
-    char input = 0;
+    postings->words = NULL;
+    postings->nWords = 0;
+    postings->nWordCap = 0;
+    postings->pool = NULL;
+    postings->nPool = 0;
+    postings->nPoolCap = 0;
+}
 
-    printf("[Y/N] \n");
-    while (!inputIsValid)
+/**
+ * @brief Removes all translation strings from a posting index.
+ *
+ * @param postings   The posting index to be cleared.
+ */
+void
+clearPostings(PostingIndex *postings)
+{
+    postings->nWords = 0;
+    postings->nPool = 0;
+}
+
+/**
+ * @brief Frees the memory used by a posting index.
+ *
+ * @param postings   The posting index to be freed.
+ */
+void
+freePostings(PostingIndex *postings)
+{
+    free(postings->words);
+    free(postings->pool);
+}
+
+/**
+ * @brief
+ *    Returns the locations of a translation string, making room for the
+ *    strings up to its ID first (with no locations) if the posting index
+ *    does not cover it yet. The posting index is keyed by the IDs of the
+ *    string pool, so no string has to be hashed or compared.
+ *
+ * @param postings   The posting index where the string is added.
+ * @param nId        The string ID of the translation (see internString()).
+ *
+ * @return Returns the locations of the translation string.
+ */
+WordPostings *
+internWord(PostingIndex *postings,
+           int nId)
+{
+    WordPostings *word;
+    int i;
+
+    if (nId >= postings->nWords)
     {
-        input = getCharInput();
-        input = tolower(input); // to avoid checking with two chars every time
-        if (input == CONFIRM_YES || input == CONFIRM_NO)
+        postings->words = (WordPostings *)growArray(postings->words,
+                                                    &postings->nWordCap,
+                                                    nId + 1,
+                                                    sizeof(WordPostings));
+        for (i = postings->nWords; i <= nId; i++)
         {
-            inputIsValid = 1;
+            word = &postings->words[i];
+            word->offset = 0;
+            word->count = 0;
+            word->capacity = 0;
         }
-    }
 
-    switch (input)
-    {
-        case CONFIRM_YES:
-            confirm = 1;
-            break;
-        case CONFIRM_NO:
-            confirm = 0;
-            break;
+        postings->nWords = nId + 1;
     }
 
-    return confirm;
+    return &postings->words[nId];
 }
 
 /**
- * @brief This function asks the user if the entry is for a new entry or not.
+ * @brief Returns the locations of a translation string.
+ *
+ * @param postings   The posting index to be searched.
+ * @param nId        The string ID of the translation (-1 if it has none).
  *
  * @return
- *    1   if it is for a new entry (the user answered 'yes').
- *    0   if it is not for a new entry (the user answered 'no').
+ *    The locations of the string   if it is in the posting index.
+ *    NULL                          if not.
  */
-int
-isNewEntry()
+WordPostings *
+findWord(PostingIndex *postings,
+         int nId)
 {
-    displayDivider();
-
-    printf("Is this for a new entry? ");
-    return getUserConfirmation();
+    return nId < 0 || nId >= postings->nWords ? NULL : &postings->words[nId];
 }
 
 /**
- * @brief
- *    This function assigns the new entries from the temporary variables to
- *    the actual array of entries.
+ * @brief Returns the locations of a translation string.
  *
- * @param entries        An array of structures containing all the entries and
- *                       language-translation pairs.
- * @param nEntryCount    The current number entries in the entry list.
- * @param tempLangVar    The string where the language input is temporarily
- *                       stored.
- * @param tempTransVar   The string where the translation input is temporarily
- *                       stored.
+ * @param postings   The posting index containing the string.
+ * @param word       The translation string.
  *
- * @pre   tempLangVar's length is <= MAX_LANG_LEN.
- * @pre   tempTransVar's length is <= MAX_TL_LEN.
- * @pre   nEntryCount is >= 0 and < MAX_ENTRIES.
+ * @return
+ *    The address of the first location. It is only valid until the next
+ *    location is added, since the posting pool may be moved when it grows.
  */
-void
-assignNewEntries(Entry *entries,
-                 int nEntryCount,
-                 String20 tempLangVar,
-                 String20 tempTransVar)
+Posting *
+getPostings(PostingIndex *postings,
+            WordPostings *word)
 {
-    // assign the new entries to the nearest uninitialized entry
-    int curEntryCount = entries[nEntryCount].count;
-    copyLangTLPair(entries[nEntryCount].lang[curEntryCount],
-                   entries[nEntryCount].trans[curEntryCount],
-                   tempLangVar, tempTransVar);
-
-    entries[nEntryCount].count++;
+    return &postings->pool[word->offset];
 }
 
 /**
  * @brief
- *    This function asks the user for more language-translation pairs to add
- *    under the same entry until the maximum number of pairs or if the user
- *    no longer wants to add pairs.
- *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
+ *    Makes sure that there is room for one more location of a translation
+ *    string in the posting pool, in the same way as reservePair().
  *
- * @pre   nEntryCount is >= 0 and < MAX_ENTRIES.
+ * @param postings   The posting index containing the string.
+ * @param word       The translation string.
  */
 void
-addMoreTrans(Entry *entries, 
-             int nEntryCount, 
-             int nManageChoice)
+reservePosting(PostingIndex *postings,
+               WordPostings *word)
 {
-    String20 tempLangVar, tempTransVar;
+    int newCapacity;
 
-    int over = 0;
-    while (!over && entries[nEntryCount].count < MAX_COUNT)
-    {
-        if (entries[nEntryCount].count > 1)
-        {
-            displayDivider();
-            printf("Do you want to add more language-translation pairs ");
-            printf("for this entry? ");
-            over = !getUserConfirmation();
-        }
+    if (word->count < word->capacity)
+        return;
 
-        if (!over)
-        {
-            // if the user chooses yes or there are < 2 language-translation
-            // pairs in the entry
-            getLangTrans(tempLangVar, tempTransVar);
-            assignNewEntries(entries, nEntryCount, tempLangVar, tempTransVar);
-            displayDivider();
-            printf("Format (Language: Translation)\n");
-            displayCurrent(entries, nEntryCount, nManageChoice);
-        }
-        else
-        {
-            // if the user chooses no
-            displayDivider();
-            printf("Going back to the Manage Data Menu now...\n");
-        }
+    // a string with no room yet starts at the end of the pool
+    if (word->capacity == 0)
+        word->offset = postings->nPool;
 
-        // check if the current count of pairs have already reached the maximum
-        if (entries[nEntryCount].count == MAX_COUNT)
-        {
-            displayDivider();
-            printf("This entry has already reached the maximum number ");
-            printf("of pairs (%d).\n", MAX_COUNT);
-            printf("Going back to the Manage Data Menu now...\n");
-        }
+    if (word->offset + word->capacity == postings->nPool)
+    {
+        // the string is the last block of the pool
+        postings->pool = (Posting *)growArray(postings->pool,
+                                              &postings->nPoolCap,
+                                              postings->nPool + 1,
+                                              sizeof(Posting));
+        word->capacity++;
+        postings->nPool++;
+    }
+    else
+    {
+        newCapacity = word->capacity * 2;
+        postings->pool = (Posting *)growArray(postings->pool,
+                                              &postings->nPoolCap,
+                                              postings->nPool + newCapacity,
+                                              sizeof(Posting));
+        memcpy(&postings->pool[postings->nPool],
+               &postings->pool[word->offset], word->count * sizeof(Posting));
+        word->offset = postings->nPool;
+        word->capacity = newCapacity;
+        postings->nPool += newCapacity;
     }
 }
 
 /**
  * @brief
- *    This function handles the display message when the user tries to use a
- *    feature that requires at least one entry, when there is no entry added
- *    yet.
+ *    Returns where a location is, or where it should be inserted, in the
+ *    sorted locations of a translation string (binary search).
  *
- * @param nManageChoice The user's choice in the Manage Data menu.
+ * @param postings   The posting index containing the string.
+ * @param word       The translation string and its locations.
+ * @param nEntry     The index of the entry of the location.
+ * @param nPair      The index of the pair of the location.
  *
- * @pre   nManageChoice is >= 2 and <= 8.
+ * @return Returns the index of the first location that is not before it.
  */
-void
-displayNoneMsg(int nManageChoice)
+int
+findPosting(PostingIndex *postings,
+            WordPostings *word,
+            int nEntry,
+            int nPair)
 {
-    displayDivider();
+    int nLow = 0, nHigh = word->count, nMid;
+    Posting *posting;
 
-    switch (nManageChoice)
+    while (nLow < nHigh)
     {
-        case 2:
-            printf("This entry does not exist. ");
-            printf("You must first utilize the Add Entry feature.\n");
-            break;
-        case 3:
-        case 4:
-            printf("There are no entries yet. ");
-            printf("Hence, you can't delete anything for now.\n");
-            break;
-        case 5:
-            printf("There are no entries to display yet.\n");
-            break;
-        case 6:
-            printf("There are no entries that contain this word.\n");
-            break;
-        case 7:
-            printf("This language-translation pair does not exist.\n");
-            break;
-        case 8:
-            printf("There is no data to export yet.\n");
-            break;
+        nMid = nLow + (nHigh - nLow) / 2;
+        posting = &postings->pool[word->offset + nMid];
+
+        if (posting->entry < nEntry ||
+            (posting->entry == nEntry && posting->pair < nPair))
+            nLow = nMid + 1;
+        else
+            nHigh = nMid;
     }
+
+    return nLow;
 }
 
 /**
- * @brief This function asks the user which entry does he or she wants to add
- * the pair into.
+ * @brief Initializes an empty table cache.
  *
- * @param nEntryChoice   The address where the user's choice will be stored.
- * @param arrMatched     The array where the indices of the matched entries
- *                       are stored.
- * @param nMatches       The number of matched entries found in the search.
+ * @param cache     The table cache to be initialized.
+ * @param nBudget   The most bytes the tables can use.
+ */
+void
+initTables(TableCache *cache,
+           size_t nBudget)
+{
+    cache->tables = NULL;
+    cache->nTables = 0;
+    cache->nTableCap = 0;
+    cache->nBudget = nBudget;
+    cache->nUsed = 0;
+    cache->nClock = 0;
+    cache->nPaused = 0;
+}
+
+/**
+ * @brief Removes a table from a table cache and frees its translations.
  *
- * @pre   nMatches is >= 1 and <= MAX_ENTRIES.
+ * @param cache    The table cache containing the table.
+ * @param nTable   The index of the table to be removed.
  */
 void
-getEntryChoice(int *nEntryChoice, 
-               int *arrMatched, 
-               int nMatches)
+dropTable(TableCache *cache,
+          int nTable)
 {
-    int nChoice;
+    PairTable *table = &cache->tables[nTable];
 
-    displayDivider();
-    printf("Which entry do you want to add a language-translation pair?\n");
-    nChoice = getIntInput(1, nMatches);
+    cache->nUsed -= (size_t)table->nIdCap * sizeof(int);
+    free(table->arrTrans);
 
-    // assign the index of the entry to the user's choice variable
-    *nEntryChoice = arrMatched[nChoice - 1];
+    // the last table takes its place
+    cache->nTables--;
+    cache->tables[nTable] = cache->tables[cache->nTables];
 }
 
 /**
- * @brief This function checks if the language input is in the specific entry.
- *
- * @param entries         An array of structures containing all the entries
- *                        and language-translation pairs.
- * @param strLang         The string that contains the tested language.
- * @param nCurrentEntry   The index of the entry being tested.
- *
- * @pre   nCurrentEntry is >= 0 and <= nEntryCount - 1.
+ * @brief
+ *    Removes all the tables from a table cache. This is used when the
+ *    string IDs change.
  *
- * @return
- *    1   if the language is in the entry.
- *    0   if not.
+ * @param cache   The table cache to be cleared.
  */
-int
-isLangInEntry(Entry *entries, 
-              String20 strLang,
-              int nCurrentEntry)
+void
+clearTables(TableCache *cache)
 {
-    int i, nReturn = 0;
-
-    // look for the language within the entry (intra-entry)
-    for (i = 0; i < entries[nCurrentEntry].count && nReturn == 0; i++)
+    while (cache->nTables > 0)
     {
-        if (!strcmp(entries[nCurrentEntry].lang[i], strLang))
-        {
-            nReturn = 1;
-        }
+        dropTable(cache, cache->nTables - 1);
     }
-
-    return nReturn;
 }
 
 /**
- * @brief This function swaps two entries within the array of structures.
+ * @brief Frees the memory used by a table cache.
  *
- * @param entries   Array of structures containing all the entries and
- *                  language-translation pairs.
- * @param nEntry1   The index of the first entry.
- * @param nEntry2   The index of the second entry.
- *
- * @pre   nEntry1 and nEntry are >= 0 and <= nEntryCount - 1, where
- *        where nEntryCount is the current amount of entries.
+ * @param cache   The table cache to be freed.
  */
 void
-swapEntry(Entry *entries, 
-          int nEntry1, 
-          int nEntry2)
+freeTables(TableCache *cache)
 {
-    Entry temp = {};
-
-    temp = entries[nEntry1];
-    entries[nEntry1] = entries[nEntry2];
-    entries[nEntry2] = temp;
+    clearTables(cache);
+    free(cache->tables);
 }
 
 /**
- * @brief This function swaps two language-translation pairs within an entry.
+ * @brief Initializes an empty translation memory.
  *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryIndex   The index of entry where its pairs will be swapped.
- * @param nIndex1       The index of the first language-translation pair.
- * @param nIndex2       The index of the second language-translation pair.
- *
- * @pre   nEntryIndex is >= 0 and <= nEntryCount - 1.
- * @pre   nIndex1 and nIndex2 are >= 0 and <= entries[nEntryIndex].count - 1.
+ * @param memory      The translation memory to be initialized.
+ * @param nMaxLines   The most lines the memory keeps.
  */
 void
-swapLangTrans(Entry *entries, 
-              int nEntryIndex, 
-              int nIndex1, 
-              int nIndex2)
+initMemory(TransMemory *memory,
+           int nMaxLines)
 {
-    String20 tempLangVar, tempTransVar;
-
-    // assign first language-translation pair to temporary string variables
-    copyLangTLPair(tempLangVar, tempTransVar,
-                   entries[nEntryIndex].lang[nIndex1],
-                   entries[nEntryIndex].trans[nIndex1]);
-
-    // assign the second language-translation pair to the first
-    // language-translation pair
-    copyLangTLPair(entries[nEntryIndex].lang[nIndex1],
-                   entries[nEntryIndex].trans[nIndex1],
-                   entries[nEntryIndex].lang[nIndex2],
-                   entries[nEntryIndex].trans[nIndex2]);
-
-    // assign the temporary variables to the second language-translation pair
-    copyLangTLPair(entries[nEntryIndex].lang[nIndex2],
-                   entries[nEntryIndex].trans[nIndex2],
-                   tempLangVar, tempTransVar);
+    memory->lines = NULL;
+    memory->nLines = 0;
+    memory->nLineCap = 0;
+    memory->nMaxLines = nMaxLines;
+    memory->buckets = NULL;
+    memory->nBuckets = 0;
+    memory->nNewest = -1;
+    memory->nOldest = -1;
+    memory->nHits = 0;
+    memory->nMisses = 0;
 }
 
 /**
  * @brief
- *    This function arranges the entries by placing entries with the language
- *    string "English" first, and they are arranged based on order of entry.
- *    Meanwhile, entries without the "English" language string are placed at
- *    the end of the entries, unsorted or not.
- *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
+ *    Removes all the lines from a translation memory, since a change to
+ *    the dictionary can change the translation of any of them. The hits
+ *    and misses are kept.
  *
- * @pre   nEntryCount is >= 0 and <= MAX_ENTRIES.
+ * @param memory   The translation memory to be cleared.
  */
 void
-arrangeInterEnt(Entry *entries, 
-                int nEntryCount)
+clearMemory(TransMemory *memory)
 {
-    int i, j;
+    int i;
 
-    // go through each entry and see if it has the "English" language in it
-    for (i = 0; i < nEntryCount - 1; i++)
+    for (i = 0; i < memory->nLines; i++)
     {
-        // if the entry does not have "English" in it, find the nearest
-        // entry with "English" and swap them
-        if (!isLangInEntry(entries, "English", i))
-        {
-            for (j = i + 1; j < nEntryCount; j++)
-            {
-                if (isLangInEntry(entries, "English", j))
-                {
-                    swapEntry(entries, i, j);
-                    j = nEntryCount; // end the inner loop
-                }
-            }
-        }
+        free(memory->lines[i].words);
+    }
+
+    for (i = 0; i < memory->nBuckets && memory->nLines > 0; i++)
+    {
+        memory->buckets[i] = -1;
     }
+
+    memory->nLines = 0;
+    memory->nNewest = -1;
+    memory->nOldest = -1;
 }
 
 /**
- * @brief
- *    This function arranges the language-translation pairs within an entry
- *    alphabetically based on language.
+ * @brief Frees the memory used by a translation memory.
  *
- * @param entries       An array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
- *
- * @pre   nEntryCount is >= 0 and <= MAX_ENTRIES.
+ * @param memory   The translation memory to be freed.
  */
 void
-arrangeIntraEnt(Entry *entries, 
-                int nEntryCount)
+freeMemory(TransMemory *memory)
 {
-    int i, j, l, min;
-
-    for (i = 0; i < nEntryCount; i++)
-    {
-        // set the following initialization in the loop:
-        // j = 0; if the intra-entry sorting includes the "source" pair
-        // j = 1; if the intra-entry sorting doesn't include the "source" pair
-        for (j = 1; j < entries[i].count - 1; j++)
-        {
-            min = j;
-
-            // look for the "least" entry alphabetically to be
-            // replaced with the first unsorted element in the array
-            for (l = j + 1; l < entries[i].count; l++)
-            {
-                if (strcmp(entries[i].lang[l], entries[i].lang[min]) < 0)
-                    min = l;
-            }
-
-            // don't swap if destination and source pair are the same
-            if (min != j)
-            {
-                swapLangTrans(entries, i, min, j);
-            }
-        }
-    }
+    clearMemory(memory);
+    free(memory->lines);
+    free(memory->buckets);
 }
 
 /**
  * @brief
- *    This function displays all entries to the user by displaying each entry
- *    one at a time.
+ *    Computes the hash of a line of a translation memory from its words
+ *    and languages, so that the same words translated to other languages
+ *    are kept apart.
  *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   the current number entries in the entry list.
+ * @param lang       The language ID of the line.
+ * @param destLang   The language ID of the translation.
+ * @param words      The words of the line (see MemoryLine).
+ * @param len        The amount of characters of the words.
  *
- * @pre   nEntryCount is >= 0 and <= MAX_ENTRIES.
+ * @return Returns the hash of the line.
  */
-void
-displayAllEntries(Entry *entries, 
-                  int nEntryCount, 
-                  int nManageChoice)
+unsigned int
+hashLine(int lang,
+         int destLang,
+         char *words,
+         int len)
 {
-    int k = 0;
-    char cDispChoice;
-
-    // arrange the entries inter-entry (those with "English" go first)
-    arrangeInterEnt(entries, nEntryCount);
-
-    // arrange the entries intra-entry (language-translation pairs)
-    arrangeIntraEnt(entries, nEntryCount);
-
-    while (k >= 0 && k < nEntryCount)
-    {
-        displayCurrent(entries, k, nManageChoice);
-        getDispChoice(&cDispChoice, k, nEntryCount);
-
-        // adjust the index of the entry being displayed depending on
-        // the user's command
-        switch (cDispChoice)
-        {
-            case ENTRY_OPTION_NEXT:
-                k++;
-                break;
-            case ENTRY_OPTION_PREV:
-                k--;
-                break;
-            default:
-                k = nEntryCount;
-                break; // exit
-        }
-    }
+    return hashLangTLPair(lang,
+                          hashLangTLPair(destLang,
+                                         hashBytes(words, len,
+                                                   2166136261u)));
 }
 
 /**
  * @brief
- *    This function gets the choice of the user on which entry to delete or
- *    delete from.
- *
- * @param nDelChoice    Address where the user's entry choice to delete is
- *                      stored.
- * @param nEntryCount   The current number entries in the entry list.
+ *    Returns the line of a translation memory with the given words and
+ *    languages.
  *
- * @pre *nDelChoice is >= 1 and <= MAX_ENTRIES.
+ * @param memory     The translation memory to be searched.
+ * @param hash       The hash of the line (see hashLine()).
+ * @param lang       The language ID of the line.
+ * @param destLang   The language ID of the translation.
+ * @param isExact    1 if the words are the line as it is, 0 if not.
+ * @param words      The words of the line (see MemoryLine).
+ * @param len        The amount of characters of the words.
  *
  * @return
- *    1   if the user entered a valid input.
- *    0   if invalid.
+ *    The index of the line   if it is in the memory.
+ *    -1                      if not.
  */
 int
-getDelChoice(int *nDelChoice, 
-             int nEntryCount)
+findMemoryLine(TransMemory *memory,
+               unsigned int hash,
+               int lang,
+               int destLang,
+               int isExact,
+               char *words,
+               int len)
 {
-    int nReturn;
+    MemoryLine *line;
+    int nLine = -1;
 
-    displayDivider();
-    printf("Enter the entry number.\n");
-    *nDelChoice = getIntInput(INT_MIN, INT_MAX);
+    if (memory->nLines > 0)
+        nLine = memory->buckets[hash & (memory->nBuckets - 1)];
 
-    // handle invalid input
-    if ((*nDelChoice) >= 1 && (*nDelChoice) <= nEntryCount)
-        nReturn = 1;
-    else
-        nReturn = 0;
+    // the words are compared too, so two lines never share a translation
+    // just because their hashes are equal
+    while (nLine != -1)
+    {
+        line = &memory->lines[nLine];
+        if (line->hash == hash && line->lang == lang &&
+            line->destLang == destLang && line->isExact == isExact &&
+            line->nWordsLen == len &&
+            !memcmp(line->words, words, len))
+            return nLine;
+
+        nLine = line->nNext;
+    }
 
-    return nReturn;
+    return -1;
 }
 
 /**
  * @brief
- *    This function displays a message to the user that the entered input is
- *    invalid.
+ *    Takes a line out of the order of use of a translation memory (see
+ *    useMemoryLine()).
  *
+ * @param memory   The translation memory containing the line.
+ * @param nLine    The index of the line.
  */
 void
-displayInvDel()
+unlinkMemoryLine(TransMemory *memory,
+                 int nLine)
 {
-    displayDivider();
-    printf("Input is invalid. Going back to the Manage Data Menu now...\n");
+    MemoryLine *line = &memory->lines[nLine];
+
+    if (line->nNewer != -1)
+        memory->lines[line->nNewer].nOlder = line->nOlder;
+    else
+        memory->nNewest = line->nOlder;
+
+    if (line->nOlder != -1)
+        memory->lines[line->nOlder].nNewer = line->nNewer;
+    else
+        memory->nOldest = line->nNewer;
 }
 
 /**
- * @brief This function deletes an entry from the list of entries.
- *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
- * @param nDelChoice    The index of the entry number that the user wants to
- *                      delete subtracted by 1.
+ * @brief Makes a line the most recently used line of a translation memory.
  *
- * @pre   nEntryCount is > 0 and <= MAX_ENTRIES.
- * @pre   nDelChoice is >= 1 and <= MAX_ENTRIES.
+ * @param memory   The translation memory containing the line.
+ * @param nLine    The index of the line, which is not in the order of use
+ *                 (see unlinkMemoryLine()).
  */
 void
-deleteEntry(Entry *entries, 
-            int nEntryCount, 
-            int nDelChoice)
+useMemoryLine(TransMemory *memory,
+              int nLine)
 {
-    int i;
+    MemoryLine *line = &memory->lines[nLine];
 
-    // immediately start shifting entries forward until the
-    // last entry is copied
-    for (i = nDelChoice - 1; i <= nEntryCount - 2; i++)
-    {
-        entries[i] = entries[i + 1];
-    }
+    line->nNewer = -1;
+    line->nOlder = memory->nNewest;
+    if (memory->nNewest != -1)
+        memory->lines[memory->nNewest].nNewer = nLine;
+    else
+        memory->nOldest = nLine;
 
-    clearEntry(&entries[i]); // clear the last entry
+    memory->nNewest = nLine;
 }
 
 /**
  * @brief
- *    This function gets the index of the pair from a specific entry that
- *    the user wants to delete.
- *
- * @param entries      Array of structures containing all the entries and
- *                     language-translation pairs.
- * @param nDelIndex    Address where the user's choice of pair within an entry
- *                     to delete will be stored.
- * @param nDelChoice   The index of the entry number that the user wants to
- *                     delete subtracted by 1.
+ *    Adds the translation of a line to a translation memory. Once the
+ *    memory is full, the least recently used line makes room for it.
  *
- * @pre   nDelChoice is >= 1 and <= MAX_ENTRIES.
- * @pre   *nDelIndex is >= 1 and <= MAX_COUNT.
+ * @param memory     The translation memory where the line is added.
+ * @param hash       The hash of the line (see hashLine()).
+ * @param lang       The language ID of the line.
+ * @param destLang   The language ID of the translation.
+ * @param isExact    1 if the words are the line as it is, 0 if not.
+ * @param words      The words of the line (see MemoryLine).
+ * @param len        The amount of characters of the words.
+ * @param trans      The translation of the line.
+ * @param nTransLen  The amount of characters of the translation.
  *
- * @return
- *    1   if the user inputs a valid number (1 to the entry's pair count).
- *    0   otherwise.
+ * @pre   The line is not in the memory yet.
  */
-int
-getDelIndex(Entry *entries, 
-            int *nDelIndex, 
-            int nDelChoice)
+void
+addMemoryLine(TransMemory *memory,
+              unsigned int hash,
+              int lang,
+              int destLang,
+              int isExact,
+              char *words,
+              int len,
+              char *trans,
+              int nTransLen)
 {
-    int nReturn;
-
-    int over = 0;
-    while (!over)
-    {
-        over = 1; // assume that the input is valid
+    MemoryLine *line;
+    int *pLink;
+    int i, nLine;
 
-        printf("\nWhat language-translation pair do you want to delete?\n");
-        *nDelIndex = getIntInput(INT_MIN, INT_MAX);
+    if (memory->nMaxLines == 0)
+        return;
 
-        // if input is invalid, ask user if they wish to continue
-        // otherwise, loop will automatically stop
-        // set the following conditions in the if condition:
-        // *nDelIndex < 1; if the user can delete the "source" pair
-        // *nDelIndex < 2; if the user can't delete the "source" pair
-        if (*nDelIndex < 2 || *nDelIndex > entries[nDelChoice - 1].count)
+    if (memory->buckets == NULL)
+    {
+        // at most one line per bucket on average once the memory is full
+        memory->nBuckets = INDEX_MIN_BUCKETS;
+        while (memory->nBuckets < memory->nMaxLines)
         {
-            printf("\nInput is invalid. ");
+            memory->nBuckets *= 2;
+        }
 
-            if (*nDelIndex == 1)
-                printf("You can't delete the \"source\" pair. ");
+        memory->buckets = (int *)malloc(memory->nBuckets * sizeof(int));
+        if (memory->buckets == NULL)
+        {
+            printf("Out of memory! Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
 
-            printf("Do you still want to delete translation? ");
-            over = !getUserConfirmation();
+        for (i = 0; i < memory->nBuckets; i++)
+        {
+            memory->buckets[i] = -1;
         }
     }
 
-    if ((*nDelIndex) >= 1 && (*nDelIndex) <= entries[nDelChoice - 1].count)
-        nReturn = 1;
+    if (memory->nLines < memory->nMaxLines)
+    {
+        memory->lines = (MemoryLine *)growArray(memory->lines,
+                                                &memory->nLineCap,
+                                                memory->nLines + 1,
+                                                sizeof(MemoryLine));
+        nLine = memory->nLines++;
+    }
     else
-        nReturn = 0;
+    {
+        // the oldest line is taken out of its bucket and reused
+        nLine = memory->nOldest;
+        line = &memory->lines[nLine];
+        pLink = &memory->buckets[line->hash & (memory->nBuckets - 1)];
+        while (*pLink != nLine)
+        {
+            pLink = &memory->lines[*pLink].nNext;
+        }
 
-    return nReturn;
+        *pLink = line->nNext;
+        unlinkMemoryLine(memory, nLine);
+        free(line->words);
+    }
+
+    line = &memory->lines[nLine];
+    line->words = (char *)malloc(len + nTransLen + 1);
+    if (line->words == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(line->words, words, len);
+    memcpy(&line->words[len], trans, nTransLen);
+    line->hash = hash;
+    line->lang = lang;
+    line->destLang = destLang;
+    line->isExact = isExact;
+    line->nWordsLen = len;
+    line->nTransLen = nTransLen;
+    line->nNext = memory->buckets[hash & (memory->nBuckets - 1)];
+    memory->buckets[hash & (memory->nBuckets - 1)] = nLine;
+    useMemoryLine(memory, nLine);
 }
 
 /**
- * @brief This function deletes a language-translation pair from an entry.
+ * @brief
+ *    Marks the translations that a change to the pairs of an entry may
+ *    affect, so they are computed again the next time their table is used
+ *    (see getPairTable()). This is called both before and after the pairs
+ *    of an indexed entry change, and after an entry is moved, since the
+ *    first entry with a translation is the one that is used.
  *
- * @param entries      Array of structures containing all the entries and
- *                     language-translation pairs.
- * @param nDelChoice   The index of the entry number that the user wants to
- *                     delete, added by 1.
- * @param nDelIndex    The index of the language-translation pair that the
- *                     user wants to delete from an entry, added by 1.
+ * @details
+ *    Only the words of the entry in the language of a table can have a
+ *    different direct translation (or first half of a chained one). The
+ *    second half of a chained translation can change for any word if the
+ *    entry has both the pivot and the destination language, in which case
+ *    the whole table is computed again.
  *
- * @pre   nDelChoice is >= 1 and <= MAX_ENTRIES.
- * @pre   nDelIndex is >= 1 and <= MAX_COUNT.
+ * @param dict     The dictionary containing the entry and the tables.
+ * @param nEntry   The index of the entry.
  */
 void
-deleteTrans(Entry *entries, 
-            int nDelChoice, 
-            int nDelIndex)
+invalidateTables(Dictionary *dict,
+                 int nEntry)
 {
-    int i;
-
-    nDelChoice--; // since the entries array is 0-based
-    for (i = nDelIndex - 1; i < entries[nDelChoice].count - 1; i++)
+    TableCache *cache = &dict->tables;
+    PairTable *table;
+    Pair *pairs = getPair(dict, nEntry, 0);
+    int count = dict->entries[nEntry].count;
+    int i, j, nId;
+    int hasDest, hasPivot;
+
+    for (i = 0; i < cache->nTables && cache->nPaused == 0; i++)
     {
-        // immediately start shifting pairs forward until the
-        // last pair is copied
-        copyLangTLPair(entries[nDelChoice].lang[i],
-                       entries[nDelChoice].trans[i],
-                       entries[nDelChoice].lang[i + 1],
-                       entries[nDelChoice].trans[i + 1]);
-    }
+        table = &cache->tables[i];
+        hasDest = 0;
+        hasPivot = 0;
+        for (j = 0; j < count; j++)
+        {
+            nId = pairs[j].trans;
+            hasDest = hasDest || pairs[j].lang == table->destLang;
+            hasPivot = hasPivot || pairs[j].lang == table->nPivotLang;
 
-    // empty the strings of the last initialized pair
-    clearLangTLPair(entries[nDelChoice].lang[i], entries[nDelChoice].trans[i]);
+            // IDs past the end of the table are computed once it grows
+            if (pairs[j].lang == table->lang && nId < table->nIds &&
+                table->arrTrans[nId] != -2)
+            {
+                table->arrTrans[nId] = -2;
+                table->nStale++;
+            }
+        }
 
-    entries[nDelChoice].count--;
+        if (hasDest && hasPivot)
+            table->isStale = 1;
+    }
 }
 
 /**
- * @brief
- *    This function displays the message, asking the user if he or she wants
- *    to delete more language-translation pairs.
+ * @brief Adds all the pairs of an entry to the posting index.
+ *
+ * @param dict     The dictionary containing the entry and the posting index.
+ * @param nEntry   The index of the entry to be added.
  *
+ * @pre   The pairs of the entry are not in the posting index yet.
  */
 void
-displayDelAgain()
+indexWords(Dictionary *dict,
+           int nEntry)
 {
-    displayDivider();
-    printf("Do you want to delete more language-translation pairs? ");
-}
+    Pair *pairs = getPair(dict, nEntry, 0);
+    WordPostings *word;
+    Posting *locations;
+    int j, k;
+
+    invalidateTables(dict, nEntry);
+
+    for (j = 0; j < dict->entries[nEntry].count; j++)
+    {
+        word = internWord(&dict->postings, pairs[j].trans);
+        reservePosting(&dict->postings, word);
+        locations = getPostings(&dict->postings, word);
+
+        // entries are mostly indexed in order, so this is usually the end
+        k = findPosting(&dict->postings, word, nEntry, j);
+        memmove(&locations[k + 1], &locations[k],
+                (word->count - k) * sizeof(Posting));
+        locations[k].entry = nEntry;
+        locations[k].pair = j;
+        word->count++;
+    }
+}
 
 /**
  * @brief
- *    Returns the index of where a language-translation pair is first found in
- *    an entry.
- *
- * @param givenEntry   The entry to be searched in.
- * @param lang         The language string to be searched for.
- * @param tl           The translation string to be searched for.
- * @param start        Index of first string to be searched.
- * @param end          Index of last string to be searched.
- *                     If -1 is passed, until the last string is searched.
+ *    Removes all the pairs of an entry from the posting index. This is used
+ *    before the pairs of an indexed entry are changed.
  *
- * @pre   start is >= 0.
- * @pre   end is < the amount of language-translation pairs in the entry,
- *        if end is != -1.
- * @pre   start is <= end, if end is != -1.
+ * @param dict     The dictionary containing the entry and the posting index.
+ * @param nEntry   The index of the entry to be removed.
  *
- * @return
- *    Index of first found lang-tl pair   if the lang-tl pair was found.
- *    -1                                  if the lang-tl pair was not found.
+ * @pre   The pairs of the entry are in the posting index.
  */
-int
-isPairInEntry(Entry *givenEntry, 
-              char *lang, 
-              char *tl, 
-              int start, 
-              int end)
+void
+unindexWords(Dictionary *dict,
+             int nEntry)
 {
-    int i, nReturn = -1;
+    Pair *pairs = getPair(dict, nEntry, 0);
+    WordPostings *word;
+    Posting *locations;
+    int j, k;
 
-    end = end == -1 ? givenEntry->count - 1 : end;
-    for (i = start; i <= end; i++)
+    invalidateTables(dict, nEntry);
+
+    for (j = 0; j < dict->entries[nEntry].count; j++)
     {
-        if (!strcmp(lang, givenEntry->lang[i]) &&
-            !strcmp(tl, givenEntry->trans[i]))
-        {
-            nReturn = i; // return the index of where the pair was found
-            i = end + 1; // end the loop
-        }
+        word = findWord(&dict->postings, pairs[j].trans);
+        locations = getPostings(&dict->postings, word);
+        k = findPosting(&dict->postings, word, nEntry, j);
+        memmove(&locations[k], &locations[k + 1],
+                (word->count - k - 1) * sizeof(Posting));
+        word->count--;
     }
-
-    return nReturn;
 }
 
 /**
  * @brief
- *    This function checks if the given language and translation input is
- *    already existing in the list of entries.
+ *    Checks if an entry has been added to the indexes. Entries are indexed
+ *    in order once they are complete, so only an entry that is still being
+ *    added or loaded is not.
  *
- * @param tempLangVar    The string where the language input is temporarily
- *                       stored.
- * @param tempTransVar   The string where the translation input is temporarily
- *                       stored.
- * @param nEntryCount    The current number entries in the entry list.
- * @param entries        An array of structures containing all the entries and
- *                       language-translation pairs.
- * @param arrMatched     The array where the indices of the matched entries
- *                       are stored.
- * @param pMatches       The address where the number of matched entries will
- *                       be stored.
- * @param start          Index of the first pair to be searched in all entries.
- * @param end            Index of the last pair to be searched in all entries.
- *                       If -1 is passed, all pairs in each entry are searched.
+ * @param dict     The dictionary containing the entry.
+ * @param nEntry   The index of the entry.
  *
- * @pre   nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   start is >= 0.
- * @pre   end is < the amount of language-translation pairs in all entries,
- *        if end is != -1.
- * @pre   start is <= end, if end is != -1.
+ * @return
+ *    1   if the entry is indexed.
+ *    0   if not.
+ */
+int
+isEntryIndexed(Dictionary *dict,
+               int nEntry)
+{
+    return nEntry < dict->index.nIndexed;
+}
+
+/**
+ * @brief
+ *    Checks if an entry has been deleted (see deleteEntry()). A deleted
+ *    entry stays in place with no pairs until the dictionary is compacted
+ *    (see compactEntries()), and every reader skips it.
+ *
+ * @param dict     The dictionary containing the entry.
+ * @param nEntry   The index of the entry.
  *
  * @return
- *    1   if the pair is in at least one entry.
- *    0   if the pair has no matches.
+ *    1   if the entry is deleted.
+ *    0   if not.
  */
 int
-findPairInAllEntries(String20 tempLangVar,
-                     String20 tempTransVar,
-                     int nEntryCount,
-                     Entry *entries,
-                     int *arrMatched,
-                     int *pMatches,
-                     int start,
-                     int end)
+isEntryDeleted(Dictionary *dict,
+               int nEntry)
 {
-    int i, nReturn;
-    int pairIsInEntry;
+    return isEntryIndexed(dict, nEntry) && dict->entries[nEntry].count == 0;
+}
 
-    nReturn = 0;   // assume pair is not found in any entries
-    *pMatches = 0; // initial number of matches found
+/**
+ * @brief Returns the amount of entries that have not been deleted.
+ *
+ * @param dict   The dictionary containing the entries.
+ *
+ * @return Returns the amount of entries.
+ */
+int
+countEntries(Dictionary *dict)
+{
+    return dict->nEntries - dict->nDeleted;
+}
 
-    for (i = 0; i < nEntryCount; i++)
+/**
+ * @brief
+ *    Lists the entries that are not deleted in order, so that they can be
+ *    numbered from 1 as the user sees them (see getEntryIndex()), unless
+ *    the list is already up to date. The deleted entries stay in place
+ *    until the dictionary is compacted (see compactEntries()).
+ *
+ * @param dict   The dictionary containing the entries.
+ */
+void
+numberEntries(Dictionary *dict)
+{
+    int i, nLive = 0;
+
+    if (!dict->isNumbered && dict->nDeleted > 0)
     {
-        pairIsInEntry = isPairInEntry(&entries[i], tempLangVar, tempTransVar,
-                                      start, end);
-        if (pairIsInEntry != -1)
+        dict->live = (int *)growArray(dict->live, &dict->nLiveCap,
+                                      countEntries(dict), sizeof(int));
+        for (i = 0; i < dict->nEntries; i++)
         {
-            arrMatched[*pMatches] = i; // store the index
-            *pMatches += 1;
-            nReturn = 1; // the pair was found in at least one entry
+            if (!isEntryDeleted(dict, i))
+                dict->live[nLive++] = i;
         }
-    }
 
-    return nReturn;
+        dict->isNumbered = 1;
+    }
 }
 
 /**
  * @brief
- *    Returns the index of where a translation string was first found in an
- *    entry.
+ *    Returns the index of an entry from its number among the entries that
+ *    are not deleted.
  *
- * @param givenEntry   The entry to be searched in.
- * @param tl           The translation string to be searched for.
- * @param start        Index of first string to be searched in the entry.
- * @param end          Index of last string to be searched in the entry.
- *                     If -1 is passed, until the last string is searched.
+ * @param dict      The dictionary containing the entries.
+ * @param nNumber   The number of the entry, from 0.
  *
- * @pre   start is >= 0.
- * @pre   end is < the amount of language-translation pairs in the entry,
- *        if end is != -1.
- * @pre   start is <= end, if end is != -1.
+ * @pre   nNumber is >= 0 and < countEntries(dict).
  *
- * @return
- *    Index of first found tl string   if the translation was found.
- *    -1                               if the translation was not found.
+ * @return Returns the index of the entry.
  */
 int
-isWordInEntry(Entry *givenEntry, 
-              char *tl, 
-              int start, 
-              int end)
+getEntryIndex(Dictionary *dict,
+              int nNumber)
 {
-    int i, nReturn = -1;
+    int nEntry = nNumber;
 
-    end = end == -1 ? givenEntry->count - 1 : end;
-    for (i = start; i <= end; i++)
+    if (dict->nDeleted > 0)
     {
-        if (!strcmp(tl, givenEntry->trans[i]))
-        {
-            nReturn = i; // return the index of where the word was found
-            i = end + 1; // end the loop
-        }
+        numberEntries(dict);
+        nEntry = dict->live[nNumber];
     }
 
-    return nReturn;
+    return nEntry;
 }
 
 /**
  * @brief
- *    This function searches for the input word in the list of entries, both
- *    intra-entry and inter-entry.
- *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param strKey        The string containing the word being searched.
- * @param nEntryCount   The current number entries in the entry list.
- * @param arrMatched    The array where the indices of the matched entries are
- * stored.
- * @param pMatches      The address where the number of matched entries will be
- * stored.
- * @param start         Index of the first pair to be searched in all entries.
- * @param end           Index of the last pair to be searched in all entries.
- *                      If -1 is passed, all pairs in each entry are searched.
+ *    Returns the number of an entry among the entries that are not deleted
+ *    (see getEntryIndex()), by a binary search of the entries in order.
  *
- * @pre   nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   *pMatches is >= 1 and MAX_ENTRIES.
- * @pre   start is >= 0.
- * @pre   end is < the amount of language-translation pairs in all entries,
- *        if end is != -1.
- * @pre   start is <= end, if end is != -1.
+ * @param dict     The dictionary containing the entries.
+ * @param nEntry   The index of the entry, which is not deleted.
  *
- * @return
- *    1   if the word is in at least one entry.
- *    0   if not.
+ * @return Returns the number of the entry, from 0.
  */
 int
-findWordInAllEntries(Entry *entries,
-                     String20 strKey,
-                     int nEntryCount,
-                     int *arrMatched,
-                     int *pMatches,
-                     int start,
-                     int end)
+getEntryNumber(Dictionary *dict,
+               int nEntry)
 {
-    int i;
-    int wordIsInEntry;
+    int nLow = 0, nHigh, nMid;
 
-    int nReturn = 0; // assume translation was not found in any entry
-    *pMatches = 0;   // initial number of matches found
+    if (dict->nDeleted == 0)
+        return nEntry;
 
-    for (i = 0; i < nEntryCount; i++)
+    numberEntries(dict);
+    nHigh = countEntries(dict) - 1;
+    while (nLow < nHigh)
     {
-        wordIsInEntry = isWordInEntry(&entries[i], strKey, start, end);
-        if (wordIsInEntry != -1)
-        {
-            arrMatched[*pMatches] = i; // store the index
-            *pMatches += 1;
-            nReturn = 1; // the translation was found in at least one entry
-        }
+        nMid = (nLow + nHigh) / 2;
+        if (dict->live[nMid] < nEntry)
+            nLow = nMid + 1;
+        else
+            nHigh = nMid;
     }
 
-    return nReturn;
+    return nLow;
 }
 
 /**
- * @brief This function gets the word that the user wants to search for.
+ * @brief Initializes an empty phrase trie.
  *
- * @param strKey   The string containing the word being searched.
+ * @param trie   The phrase trie to be initialized.
  */
 void
-getKey(String20 strKey)
+initPhrases(PhraseTrie *trie)
 {
-    displayDivider();
-    printf("Enter word (maximum of 20 characters).\n");
+    int i;
+
+    trie->nodes = NULL;
+    trie->nNodes = 0;
+    trie->nNodeCap = 0;
+    trie->nSlots = PHRASE_MIN_SLOTS;
+    trie->slots = (int *)malloc(trie->nSlots * sizeof(int));
+    for (i = 0; i < trie->nSlots; i++)
+    {
+        trie->slots[i] = -1;
+    }
 
-    getStrInput(strKey, MIN_TL_LEN, MAX_TL_LEN + 1);
-    lowercase(strKey);
+    initStrings(&trie->words);
 }
 
 /**
- * @brief This function gets the language input from the user.
+ * @brief Removes all phrases from a phrase trie.
  *
- * @param strLang   The string where the language input will be stored.
- * @param nType     The type of language that the user is asked (either the
- *                  language of the source text or the language to be
- *                  translated to).
- *
- * @pre   nType is either 1 or 2.
+ * @param trie   The phrase trie to be cleared.
  */
 void
-getLang(String20 strLang, 
-        int nType)
+clearPhrases(PhraseTrie *trie)
 {
-    displayDivider();
+    int i;
 
-    if (nType == 1)
-        printf("Enter language of source text ");
-    else
-        printf("Enter language to be translated to ");
+    for (i = 0; i < trie->nSlots; i++)
+    {
+        trie->slots[i] = -1;
+    }
 
-    printf("(maximum of %d characters).\n", MAX_LANG_LEN);
+    trie->nNodes = 0;
+    clearStrings(&trie->words);
+}
 
-    getStrInput(strLang, MIN_LANG_LEN, MAX_LANG_LEN + 1);
-    titleCase(strLang);
+/**
+ * @brief Frees the memory used by a phrase trie.
+ *
+ * @param trie   The phrase trie to be freed.
+ */
+void
+freePhrases(PhraseTrie *trie)
+{
+    free(trie->nodes);
+    free(trie->slots);
+    freeStrings(&trie->words);
 }
 
 /**
  * @brief
- *    This function empties the entry count, pair count per entry, and all
- *    string variables initialized when the user chooses to exit from the
- *    Manage Data menu or Translate menu.
+ *    Returns the node of the phrase trie where the first word of the
+ *    phrases of a language starts from.
  *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
+ * @param lang   The language ID of the phrases.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
+ * @return Returns the (virtual) node, which is always < -1.
  */
-void
-emptyEntry(Entry *entries, 
-           int *nEntryCount)
+int
+getPhraseRoot(int lang)
 {
-    int i;
+    return -2 - lang;
+}
+
+/**
+ * @brief
+ *    Returns the slot of the phrase trie where the child of a node for a
+ *    word is, or where it should be added if it is not in the trie yet.
+ *
+ * @param trie      The phrase trie to be searched.
+ * @param nParent   The node whose child is to be found.
+ * @param nWord     The ID of the word of the child in the words of the
+ *                  trie.
+ *
+ * @return Returns the index of the slot.
+ */
+int
+findPhraseSlot(PhraseTrie *trie,
+               int nParent,
+               int nWord)
+{
+    unsigned int edgeHash = hashLangTLPair(nParent, (unsigned int)nWord);
+    int nSlot = edgeHash & (trie->nSlots - 1);
+    PhraseNode *node;
+    int found = 0;
 
-    // empty all initialized strings of all initialized entries
-    for (i = 0; i < *nEntryCount; i++)
+    // linear probing until the child or an empty slot is found
+    while (!found && trie->slots[nSlot] != -1)
     {
-        clearEntry(&entries[i]);
+        node = &trie->nodes[trie->slots[nSlot]];
+        if (node->parent == nParent && node->word == nWord)
+            found = 1;
+        else
+            nSlot = (nSlot + 1) & (trie->nSlots - 1);
     }
 
-    // reset the entry count
-    *nEntryCount = 0;
+    return nSlot;
 }
 
 /**
- * @brief
- *    This function checks if the filename input from the user contains the
- *    text file extension (.txt).
+ * @brief Returns the child of a node of the phrase trie for a word.
  *
- * @param tempFile   The temporary string variable where the filename input
- *                   is stored.
+ * @param trie      The phrase trie to be searched.
+ * @param nParent   The node whose child is to be found.
+ * @param word      The characters of the word (not necessarily
+ *                  null-terminated).
+ * @param len       The amount of characters in the word.
+ * @param hash      The hash of the word (see hashBytes()).
  *
  * @return
- *    1   if the text file extension ".txt" is present.
- *    0   if not.
+ *    The index of the child   if there is a phrase that continues with
+ *                             the word.
+ *    -1                       if not.
  */
 int
-isExtPresent(String35 tempFile)
+findPhraseChild(PhraseTrie *trie,
+                int nParent,
+                char *word,
+                int len,
+                unsigned int hash)
 {
-    int nReturn = 0; // assume the extension is not present
-    int len;
+    int nWord;
 
-    // check if ".txt" is present in the file extension
-    len = strlen(tempFile);
-    if (len >= 5) // min of 1 char for the file name and 4 for the ".txt" part
-        if (!strcmp(&tempFile[len - 4], ".txt"))
-            nReturn = 1;
+    if (trie->nNodes == 0)
+        return -1;
 
-    return nReturn;
+    // a word that is in no phrase has no node
+    nWord = findHashedString(&trie->words, word, len, hash);
+    if (nWord == -1)
+        return -1;
+
+    return trie->slots[findPhraseSlot(trie, nParent, nWord)];
 }
 
 /**
  * @brief
- *    This function checks if the filename input from the user contains any of
- *    the invalid characters in filenames. Invalid characters in filenames
- *    include: \ / : * ? " < > |
+ *    Returns the child of a node of the phrase trie for a word, adding it
+ *    first if it is not in the trie yet.
  *
- * @param tempFile   The temporary string variable where the filename input is
- *                   stored.
- * @return
- *    1   if there are invalid characters present.
- *    0   if not.
+ * @param trie      The phrase trie where the child is added.
+ * @param nParent   The node whose child is to be added.
+ * @param word      The characters of the word (not necessarily
+ *                  null-terminated), which can be of any length.
+ * @param len       The amount of characters in the word.
+ *
+ * @return Returns the index of the child.
  */
 int
-isInvCharPres(String35 tempFile)
+addPhraseChild(PhraseTrie *trie,
+               int nParent,
+               char *word,
+               int len)
 {
+    int nWord = internString(&trie->words, word, len);
+    int nSlot = findPhraseSlot(trie, nParent, nWord);
+    PhraseNode *node;
     int i;
-    int nReturn = 0;
 
-    // assume the string does not have any invalid characters
-    // if there is at least one found, immediately exit the loop
-    int len = strlen(tempFile);
-    for (i = 0; i < len && nReturn == 0; i++)
+    if (trie->slots[nSlot] == -1)
     {
-        if (tempFile[i] == '\\' || tempFile[i] == '/' || tempFile[i] == ':' ||
-            tempFile[i] == '*' || tempFile[i] == '?' || tempFile[i] == '"' ||
-            tempFile[i] == '<' || tempFile[i] == '>' || tempFile[i] == '|')
+        // keep the table at most half full, rehashing into twice the slots
+        if ((trie->nNodes + 1) * 2 > trie->nSlots)
         {
-            nReturn = 1;
+            trie->nSlots *= 2;
+            trie->slots = (int *)realloc(trie->slots,
+                                         trie->nSlots * sizeof(int));
+            for (i = 0; i < trie->nSlots; i++)
+            {
+                trie->slots[i] = -1;
+            }
+
+            for (i = 0; i < trie->nNodes; i++)
+            {
+                node = &trie->nodes[i];
+                trie->slots[findPhraseSlot(trie, node->parent,
+                                           node->word)] = i;
+            }
+
+            nSlot = findPhraseSlot(trie, nParent, nWord);
+        }
+
+        trie->nodes = (PhraseNode *)growArray(trie->nodes, &trie->nNodeCap,
+                                              trie->nNodes + 1,
+                                              sizeof(PhraseNode));
+        node = &trie->nodes[trie->nNodes];
+        node->parent = nParent;
+        node->word = nWord;
+        node->nChildren = 0;
+
+        if (nParent >= 0)
+            trie->nodes[nParent].nChildren++;
+
+        trie->slots[nSlot] = trie->nNodes;
+        trie->nNodes++;
+    }
+
+    return trie->slots[nSlot];
+}
+
+/**
+ * @brief
+ *    Adds the words of a phrase (a translation with spaces in it) to the
+ *    phrase trie of its language.
+ *
+ * @param trie   The phrase trie where the phrase is added.
+ * @param lang   The language ID of the phrase.
+ * @param tl     The phrase, which can be of any length.
+ */
+void
+addPhrase(PhraseTrie *trie,
+          int lang,
+          char *tl)
+{
+    char *word = tl;
+    int nNode = getPhraseRoot(lang);
+    int len;
+
+    // the words are separated by one or more spaces
+    while (*word != '\0')
+    {
+        len = strcspn(word, " ");
+        if (len > 0)
+            nNode = addPhraseChild(trie, nNode, word, len);
+
+        word += len;
+        word += strspn(word, " ");
+    }
+}
+
+/**
+ * @brief
+ *    Adds the phrases among the pairs of an entry to the phrase trie, so
+ *    that a phrase in any language of the entry can be translated. Phrases
+ *    that are already in the trie are left as they are.
+ *
+ * @param dict     The dictionary containing the entry and the phrase trie.
+ * @param nEntry   The index of the entry.
+ */
+void
+indexPhrases(Dictionary *dict,
+             int nEntry)
+{
+    Pair *pairs = getPair(dict, nEntry, 0);
+    char *tl;
+    int j;
+
+    for (j = 0; j < dict->entries[nEntry].count; j++)
+    {
+        tl = getTrans(dict, &pairs[j]);
+        if (strchr(tl, ' ') != NULL)
+            addPhrase(&dict->phrases, pairs[j].lang, tl);
+    }
+}
+
+/**
+ * @brief Returns the time from a steady clock, for timing operations.
+ *
+ * @return Returns the time in seconds.
+ */
+double
+getSeconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief
+ *    Writes all the characters of a buffer to a file, with as many write()
+ *    calls as it takes.
+ *
+ * @param fd     The file descriptor, opened for writing.
+ * @param data   The characters to be written.
+ * @param len    The amount of characters to be written.
+ *
+ * @return
+ *    1   if everything was written.
+ *    0   if the file could not be written.
+ */
+int
+writeAll(int fd,
+         char *data,
+         size_t len)
+{
+    ssize_t nWritten;
+    int isWritten = 1;
+
+    while (len > 0 && isWritten)
+    {
+        nWritten = write(fd, data, len);
+        if (nWritten > 0)
+        {
+            data += nWritten;
+            len -= nWritten;
+        }
+        else if (nWritten == 0 || errno != EINTR)
+        {
+            isWritten = 0;
+        }
+    }
+
+    return isWritten;
+}
+
+/**
+ * @brief
+ *    Flushes the directory that holds a file to disk, so that a file that
+ *    was just created or renamed in it is still there after a crash.
+ *
+ * @param filename   The name of the file.
+ *
+ * @return
+ *    1   if the directory was flushed.
+ *    0   if not.
+ */
+int
+syncDirectory(char *filename)
+{
+    char *slash = strrchr(filename, '/');
+    char *dirName;
+    int fd;
+    int isSynced = 0;
+
+    // a name without a slash is in the current directory
+    if (slash == NULL)
+        dirName = copyString(".", 1);
+    else if (slash == filename)
+        dirName = copyString("/", 1);
+    else
+        dirName = copyString(filename, slash - filename);
+
+    fd = open(dirName, O_RDONLY | O_DIRECTORY);
+    if (fd != -1)
+    {
+        isSynced = fsync(fd) == 0;
+        close(fd);
+    }
+
+    free(dirName);
+
+    return isSynced;
+}
+
+/**
+ * @brief
+ *    Writes all the entries of a dictionary to a text file in the Import
+ *    format. The pairs are copied into a large buffer, which is written
+ *    with a single write() call whenever it holds EXPORT_BUFFER_SIZE
+ *    characters, instead of formatting and writing each pair separately.
+ *
+ * @param dict       The dictionary to be written. It is only read.
+ * @param filename   The name of the text file.
+ * @param stats      The amount of pairs and characters written and the time
+ *                   it took, which are set.
+ *
+ * @return
+ *    1   if the file was written.
+ *    0   if the file could not be written.
+ */
+int
+exportText(Dictionary *dict,
+           char *filename,
+           ExportStats *stats)
+{
+    char *buffer, *dest;
+    size_t nLen = 0;
+    Pair *pairs;
+    char *name;
+    size_t nNameLen, nTransLen;
+    int i, j, fd, nLast;
+    int isWritten;
+
+    stats->nBytes = 0;
+    stats->nPairs = 0;
+    stats->seconds = getSeconds();
+
+    fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        return 0;
+
+    // a pair (or the blank line after an entry) never needs more than
+    // STR175LEN characters, so the buffer is written once it is full
+    // without checking the room for each part of a pair
+    buffer = (char *)malloc(EXPORT_BUFFER_SIZE + STR175LEN);
+    if (buffer == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    isWritten = 1;
+
+    for (i = 0; i < dict->nEntries && isWritten; i++)
+    {
+        // the last "pair" of each entry is the blank line after it, while
+        // a deleted entry is not written at all
+        pairs = getPair(dict, i, 0);
+        nLast = isEntryDeleted(dict, i) ? -1 : dict->entries[i].count;
+        for (j = 0; j <= nLast && isWritten; j++)
+        {
+            dest = &buffer[nLen];
+            if (j < dict->entries[i].count)
+            {
+                name = getLangName(dict, pairs[j].lang);
+                nNameLen = strlen(name);
+                nTransLen = pairs[j].len;
+
+                memcpy(dest, name, nNameLen);
+                dest += nNameLen;
+                *dest++ = ':';
+                *dest++ = ' ';
+                memcpy(dest, getTrans(dict, &pairs[j]), nTransLen);
+                dest += nTransLen;
+            }
+
+            *dest++ = '\n';
+            nLen = dest - buffer;
+
+            if (nLen >= EXPORT_BUFFER_SIZE)
+            {
+                isWritten = writeAll(fd, buffer, nLen);
+                stats->nBytes += nLen;
+                nLen = 0;
+            }
+        }
+
+        stats->nPairs += dict->entries[i].count;
+    }
+
+    if (isWritten)
+    {
+        isWritten = writeAll(fd, buffer, nLen);
+        stats->nBytes += nLen;
+    }
+
+    if (close(fd) != 0)
+        isWritten = 0;
+
+    free(buffer);
+    stats->seconds = getSeconds() - stats->seconds;
+
+    return isWritten;
+}
+
+/**
+ * @brief
+ *    Displays how much an export wrote and how fast it was written.
+ *
+ * @param fp      The stream where the report is displayed.
+ * @param stats   The amount of pairs and characters written and the time
+ *                it took (see exportText()).
+ */
+void
+displayExportStats(FILE *fp,
+                   ExportStats *stats)
+{
+    double seconds = stats->seconds > 0 ? stats->seconds : 1e-9;
+
+    fprintf(fp, "%ld pairs, %.1f MB in %.3f s (%.1f MB/s)\n", stats->nPairs,
+            stats->nBytes / 1e6, stats->seconds,
+            stats->nBytes / 1e6 / seconds);
+}
+
+/**
+ * @brief
+ *    Runs the export of a background export job (see startExport()). The
+ *    thread of the job runs this function.
+ *
+ * @param arg   The export job (an ExportJob).
+ *
+ * @return Returns NULL.
+ */
+void *
+exportWorker(void *arg)
+{
+    ExportJob *job = (ExportJob *)arg;
+
+    job->isWritten = exportText(job->dict, job->filename, &job->stats);
+
+    pthread_mutex_lock(&job->lock);
+    job->isDone = 1;
+    pthread_mutex_unlock(&job->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief
+ *    Waits until the export running in the background (see startExport())
+ *    is done, so that the dictionary can be changed. Its report is kept
+ *    until it is displayed by reportExport().
+ *
+ * @param dict   The dictionary being exported.
+ */
+void
+waitForExport(Dictionary *dict)
+{
+    ExportJob *job = dict->exporting;
+
+    if (job != NULL && !job->isJoined)
+    {
+        pthread_join(job->thread, NULL);
+        job->isJoined = 1;
+    }
+}
+
+/**
+ * @brief Copies an array of a mapped snapshot to memory of its own.
+ *
+ * @param arr    The array to be copied.
+ * @param size   The size of the array in bytes.
+ *
+ * @return Returns the copy, which can be grown and freed.
+ */
+void *
+copyMapped(void *arr,
+           size_t size)
+{
+    void *copy = malloc(size > 0 ? size : 1);
+
+    if (copy == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(copy, arr, size);
+
+    return copy;
+}
+
+/**
+ * @brief
+ *    Copies the arrays of a string pool loaded from a snapshot out of the
+ *    mapping (see detachSnapshot()).
+ *
+ * @param pool   The string pool to be detached from its snapshot.
+ */
+void
+detachStrings(StringPool *pool)
+{
+    pool->data = (char *)copyMapped(pool->data, pool->nUsed);
+    pool->offsets = (int *)copyMapped(pool->offsets,
+                                      pool->nStrings * sizeof(int));
+    pool->slots = (int *)copyMapped(pool->slots, pool->nSlots * sizeof(int));
+}
+
+/**
+ * @brief
+ *    Copies every array of a dictionary loaded from a snapshot (see
+ *    loadSnapshot()) out of the mapping, so that the dictionary can be
+ *    changed. Nothing is done if the dictionary is not mapped.
+ *
+ * @param dict   The dictionary to be detached from its snapshot.
+ */
+void
+detachSnapshot(Dictionary *dict)
+{
+    if (dict->mapped == NULL)
+        return;
+
+    // the capacities of a mapped dictionary are its counts
+    dict->entries = (Entry *)copyMapped(dict->entries,
+                                        dict->nEntries * sizeof(Entry));
+    dict->srcKeys = (SourceKey *)copyMapped(dict->srcKeys,
+                                            dict->nEntries *
+                                            sizeof(SourceKey));
+    dict->pairs = (Pair *)copyMapped(dict->pairs,
+                                     dict->nPairs * sizeof(Pair));
+    detachStrings(&dict->langs);
+    detachStrings(&dict->strings);
+    dict->index.heads = (int *)copyMapped(dict->index.heads,
+                                          dict->index.nBuckets *
+                                          sizeof(int));
+    dict->index.next = (int *)copyMapped(dict->index.next,
+                                         dict->index.nSlots * sizeof(int));
+    dict->postings.words = (WordPostings *)copyMapped(dict->postings.words,
+                                                      dict->postings.nWords *
+                                                      sizeof(WordPostings));
+    dict->postings.pool = (Posting *)copyMapped(dict->postings.pool,
+                                                dict->postings.nPool *
+                                                sizeof(Posting));
+    dict->phrases.nodes = (PhraseNode *)copyMapped(dict->phrases.nodes,
+                                                   dict->phrases.nNodes *
+                                                   sizeof(PhraseNode));
+    dict->phrases.slots = (int *)copyMapped(dict->phrases.slots,
+                                            dict->phrases.nSlots *
+                                            sizeof(int));
+    detachStrings(&dict->phrases.words);
+
+    munmap(dict->mapped, dict->nMapped);
+    dict->mapped = NULL;
+    dict->nMapped = 0;
+}
+
+/**
+ * @brief
+ *    Prepares a dictionary to be changed: an export running in the
+ *    background is waited for, and a mapped snapshot is copied out of its
+ *    mapping (see detachSnapshot()).
+ *
+ * @param dict   The dictionary about to be changed.
+ */
+void
+beginChange(Dictionary *dict)
+{
+    waitForExport(dict);
+    detachSnapshot(dict);
+    dict->graph.isStale = 1;
+    dict->isNumbered = 0;
+    clearMemory(&dict->memory);
+}
+
+/**
+ * @brief
+ *    Writes the changes kept in memory by recordChange() to the end of the
+ *    journal file, without waiting for them to reach the disk.
+ *
+ * @param journal   The journal.
+ *
+ * @return
+ *    1   if the changes were written.
+ *    0   if the journal file could not be written.
+ */
+int
+flushJournal(Journal *journal)
+{
+    int isWritten = writeAll(journal->fd, journal->pending,
+                             journal->nPending);
+
+    journal->nPending = 0;
+
+    return isWritten;
+}
+
+/**
+ * @brief
+ *    Records a change to a dictionary in its journal (see openJournal()),
+ *    so that it can be made again when the dictionary is loaded. The
+ *    changes are kept in memory and written in batches (see syncJournal()).
+ *    The language and translation are stored after the record with their
+ *    lengths, so they can be of any length.
+ *    Nothing is done if the dictionary has no journal, or while the journal
+ *    is paused (for changes that are part of another recorded change).
+ *
+ * @param dict    The dictionary being changed.
+ * @param nOp     The change (JOURNAL_NEW_ENTRY and so on).
+ * @param nArg1   The first argument of the change (0 if none).
+ * @param nArg2   The second argument of the change (0 if none).
+ * @param lang    The language of the change (NULL if none).
+ * @param trans   The translation of the change (NULL if none).
+ */
+void
+recordChange(Dictionary *dict,
+             int nOp,
+             int nArg1,
+             int nArg2,
+             char *lang,
+             char *trans)
+{
+    Journal *journal = dict->journal;
+    JournalRecord record;
+    char *dest;
+    int nLangLen = lang != NULL ? strlen(lang) : 0;
+    int nTransLen = trans != NULL ? strlen(trans) : 0;
+    int nSize = sizeof(JournalRecord) + nLangLen + nTransLen;
+
+    if (journal == NULL || journal->nPaused > 0)
+        return;
+
+    if (journal->nPending + nSize > JOURNAL_BATCH_SIZE &&
+        journal->nPending > 0 && !flushJournal(journal))
+    {
+        printf("Cannot write the journal! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // unused bytes are cleared so that the checksum covers known values
+    memset(&record, 0, sizeof(JournalRecord));
+    record.op = nOp;
+    record.arg1 = nArg1;
+    record.arg2 = nArg2;
+    record.nLangLen = nLangLen;
+    record.nTransLen = nTransLen;
+    record.check = hashBytes(trans, nTransLen,
+                             hashBytes(lang, nLangLen,
+                                       hashBytes((char *)&record,
+                                                 sizeof(JournalRecord),
+                                                 2166136261u)));
+
+    journal->pending = (char *)growArray(journal->pending,
+                                         &journal->nPendingCap,
+                                         journal->nPending + nSize, 1);
+    dest = &journal->pending[journal->nPending];
+    memcpy(dest, &record, sizeof(JournalRecord));
+    if (lang != NULL)
+        memcpy(&dest[sizeof(JournalRecord)], lang, nLangLen);
+    if (trans != NULL)
+        memcpy(&dest[sizeof(JournalRecord) + nLangLen], trans, nTransLen);
+    journal->nPending += nSize;
+    journal->nRecords++;
+}
+
+/**
+ * @brief
+ *    Adds the "source" pair of an entry to the word index, and all of its
+ *    pairs to the posting index (and to the phrase trie if they have
+ *    several words).
+ *
+ * @param dict     The dictionary containing the entry and the indexes.
+ * @param nIndex   The index of the entry to be added.
+ *
+ * @pre   The entry has at least one language-translation pair.
+ * @pre   The entry is not in the indexes yet.
+ */
+void
+indexEntry(Dictionary *dict,
+           int nIndex)
+{
+    WordIndex *index = &dict->index;
+    SourceKey *key;
+    int nBucket;
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_INDEX_ENTRY, nIndex, 0, NULL, NULL);
+    key = &dict->srcKeys[nIndex];
+
+    // make room for the entry in the chains
+    index->next = (int *)growArray(index->next, &index->nSlots, nIndex + 1,
+                                   sizeof(int));
+
+    // keep the average chain length at 1 or less
+    if (index->nIndexed >= index->nBuckets)
+    {
+        growIndexBuckets(dict);
+    }
+
+    nBucket = hashLangTLPair(key->lang, (unsigned int)key->trans) &
+              (index->nBuckets - 1);
+    index->next[nIndex] = index->heads[nBucket];
+    index->heads[nBucket] = nIndex;
+    index->nIndexed++;
+
+    indexPhrases(dict, nIndex);
+    indexWords(dict, nIndex);
+}
+
+/**
+ * @brief
+ *    Rebuilds the word and posting indexes from scratch. This is used after
+ *    entries have been moved around the array (e.g. shifted by a deletion).
+ *    The tables of translations are kept, as the string IDs stay the same;
+ *    the entries that moved must be marked with invalidateTables().
+ *
+ * @param dict   The dictionary whose indexes are to be rebuilt.
+ */
+void
+rebuildIndex(Dictionary *dict)
+{
+    int i;
+
+    beginChange(dict);
+    clearIndex(&dict->index);
+    clearPostings(&dict->postings);
+    clearPhrases(&dict->phrases);
+
+    // the index follows from the entries, so it is not recorded, and the
+    // entries that stayed in place keep their translations
+    if (dict->journal != NULL)
+        dict->journal->nPaused++;
+    dict->tables.nPaused++;
+
+    for (i = 0; i < dict->nEntries; i++)
+    {
+        indexEntry(dict, i);
+    }
+
+    if (dict->journal != NULL)
+        dict->journal->nPaused--;
+    dict->tables.nPaused--;
+}
+
+/**
+ * @brief
+ *    Looks up the first entry whose "source" pair is the given lang-tl pair
+ *    and which has a pair in the destination language. This replaces a scan
+ *    over all entries with a walk over a single bucket of the word index.
+ *
+ * @param dict       The dictionary to be searched.
+ * @param lang       The language ID of the "source" pair to be found.
+ * @param nId        The string ID of the translation of the "source" pair
+ *                   to be found (-1 if it is not in the string pool).
+ * @param destLang   The language ID to be translated to.
+ * @param pPair      The address where the index of the destination pair
+ *                   will be stored (if found).
+ *
+ * @return
+ *    Index of the first matching entry   if there is a translation.
+ *    -1                                  if there is no translation.
+ */
+int
+findSourceEntryById(Dictionary *dict,
+                    int lang,
+                    int nId,
+                    int destLang,
+                    int *pPair)
+{
+    WordIndex *index = &dict->index;
+    unsigned int hash = hashLangTLPair(lang, (unsigned int)nId);
+    int nEntry = index->heads[hash & (index->nBuckets - 1)];
+    int nReturn = -1;
+    SourceKey *key;
+    Pair *pairs;
+    int j, count;
+
+    // a string that is not in the pool is not the translation of any pair
+    if (nId == -1)
+        nEntry = -1;
+
+    // the bucket is not ordered, so keep the lowest matching entry to
+    // translate the same way as scanning the entries in order would
+    while (nEntry != -1)
+    {
+        // only the source key is compared until the entry really matches
+        key = &dict->srcKeys[nEntry];
+
+        if (key->lang == lang && key->trans == nId &&
+            (nReturn == -1 || nEntry < nReturn))
+        {
+            pairs = getPair(dict, nEntry, 0);
+            count = dict->entries[nEntry].count;
+
+            for (j = 1; j < count; j++)
+            {
+                if (destLang == pairs[j].lang)
+                {
+                    nReturn = nEntry;
+                    *pPair = j;
+                    j = count; // end the loop
+                }
+            }
+        }
+
+        nEntry = index->next[nEntry];
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    Looks up the first entry whose "source" pair is the given lang-tl pair,
+ *    using the word index (see findSourceEntryById()).
+ *
+ * @param dict   The dictionary to be searched.
+ * @param lang   The language ID of the "source" pair to be found.
+ * @param nId    The string ID of the translation of the "source" pair to be
+ *               found (see findString()).
+ *
+ * @return
+ *    Index of the first matching entry   if there is one.
+ *    -1                                  if there is none.
+ */
+int
+findSourcePair(Dictionary *dict,
+               int lang,
+               int nId)
+{
+    WordIndex *index = &dict->index;
+    unsigned int hash = hashLangTLPair(lang, (unsigned int)nId);
+    int nEntry = index->heads[hash & (index->nBuckets - 1)];
+    int nReturn = -1;
+    SourceKey *key;
+
+    if (nId == -1)
+        nEntry = -1;
+
+    while (nEntry != -1)
+    {
+        key = &dict->srcKeys[nEntry];
+        if (key->lang == lang && key->trans == nId &&
+            (nReturn == -1 || nEntry < nReturn))
+            nReturn = nEntry;
+
+        nEntry = index->next[nEntry];
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    Returns the translation of a lang-tl pair in a destination language,
+ *    where the lang-tl pair can be any pair of an entry. An entry whose
+ *    "source" pair is the lang-tl pair is used first (see
+ *    findSourceEntryById()), so such words translate the same way as
+ *    before; otherwise the first entry that has the lang-tl pair and a pair
+ *    in the destination language is used, which is found through the
+ *    locations of the translation in the posting index.
+ *
+ * @param dict       The dictionary to be searched.
+ * @param lang       The language ID of the pair.
+ * @param nId        The string ID of the translation of the pair (-1 if it
+ *                   is not in the string pool).
+ * @param destLang   The language ID to be translated to.
+ *
+ * @return
+ *    The string ID of the translation   if there is one.
+ *    -1                                 if there is none.
+ */
+int
+findTransId(Dictionary *dict,
+            int lang,
+            int nId,
+            int destLang)
+{
+    WordPostings *word;
+    Posting *locations;
+    Pair *pairs;
+    int nEntry, nPair, i, j, count;
+    int nReturn = -1;
+
+    nEntry = findSourceEntryById(dict, lang, nId, destLang, &nPair);
+    if (nEntry != -1)
+        nReturn = getPair(dict, nEntry, nPair)->trans;
+
+    // the locations are sorted by entry, so the first one that has the
+    // destination language is the first entry
+    word = nEntry == -1 ? findWord(&dict->postings, nId) : NULL;
+    for (i = 0; word != NULL && i < word->count && nReturn == -1; i++)
+    {
+        locations = getPostings(&dict->postings, word);
+        pairs = getPair(dict, locations[i].entry, 0);
+        count = dict->entries[locations[i].entry].count;
+
+        for (j = 0; j < count && pairs[locations[i].pair].lang == lang &&
+                    nReturn == -1; j++)
+        {
+            if (pairs[j].lang == destLang && j != locations[i].pair)
+                nReturn = pairs[j].trans;
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief Initializes an empty language graph.
+ *
+ * @param graph   The language graph to be initialized.
+ */
+void
+initLangGraph(LangGraph *graph)
+{
+    graph->links = NULL;
+    graph->pivots = NULL;
+    graph->nLangs = 0;
+    graph->isStale = 1;
+}
+
+/**
+ * @brief Frees the memory used by a language graph.
+ *
+ * @param graph   The language graph to be freed.
+ */
+void
+freeLangGraph(LangGraph *graph)
+{
+    free(graph->links);
+    free(graph->pivots);
+}
+
+/**
+ * @brief
+ *    Computes the language graph of a dictionary again if the dictionary
+ *    has changed since it was last computed: two languages are linked once
+ *    for every entry where a pair of one is found with a pair of the other.
+ *    The best pivots are forgotten, and are computed again as they are
+ *    needed (see getPivotLang()).
+ *
+ * @param dict   The dictionary whose language graph is computed.
+ *
+ * @pre   No other thread is using the dictionary.
+ */
+void
+refreshLangGraph(Dictionary *dict)
+{
+    LangGraph *graph = &dict->graph;
+    int nLangs = dict->langs.nStrings;
+    Pair *pairs;
+    int i, j, k, count;
+
+    if (!graph->isStale)
+        return;
+
+    // dictionaries with too many languages are not given pivots, to keep
+    // the tables small
+    free(graph->links);
+    free(graph->pivots);
+    graph->links = NULL;
+    graph->pivots = NULL;
+    graph->nLangs = 0;
+    graph->isStale = 0;
+    if (nLangs > GRAPH_MAX_LANGS)
+        return;
+
+    graph->links = (int *)calloc((size_t)nLangs * nLangs + 1, sizeof(int));
+    graph->pivots = (int *)malloc(((size_t)nLangs * nLangs + 1) *
+                                  sizeof(int));
+    if (graph->links == NULL || graph->pivots == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    graph->nLangs = nLangs;
+    for (i = 0; i < nLangs * nLangs; i++)
+    {
+        graph->pivots[i] = -2;
+    }
+
+    // deleted entries have no pairs
+    for (i = 0; i < dict->nEntries; i++)
+    {
+        pairs = getPair(dict, i, 0);
+        count = dict->entries[i].count;
+        for (j = 0; j < count; j++)
+        {
+            for (k = j + 1; k < count; k++)
+            {
+                if (pairs[j].lang != pairs[k].lang)
+                {
+                    graph->links[pairs[j].lang * nLangs + pairs[k].lang]++;
+                    graph->links[pairs[k].lang * nLangs + pairs[j].lang]++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief
+ *    Returns the best pivot language to translate from one language to
+ *    another through, which is the language most strongly linked to both
+ *    of them (see refreshLangGraph()): the one whose weaker link is the
+ *    strongest. Once computed, the pivot of a pair of languages is cached
+ *    until the dictionary changes, so later lookups take constant time.
+ *
+ * @param dict       The dictionary containing the languages.
+ * @param lang       The language ID of the source language.
+ * @param destLang   The language ID of the destination language.
+ *
+ * @pre   The language graph is up to date (see refreshLangGraph()).
+ *
+ * @return
+ *    The language ID of the pivot   if there is one.
+ *    -1                             if no language links them.
+ */
+int
+getPivotLang(Dictionary *dict,
+             int lang,
+             int destLang)
+{
+    LangGraph *graph = &dict->graph;
+    int nLangs = graph->nLangs;
+    int *pivot;
+    int i, nWeak, nBest = 0;
+
+    if (lang < 0 || destLang < 0 || lang >= nLangs || destLang >= nLangs ||
+        lang == destLang)
+        return -1;
+
+    pivot = &graph->pivots[lang * nLangs + destLang];
+    if (*pivot == -2)
+    {
+        *pivot = -1;
+        for (i = 0; i < nLangs; i++)
+        {
+            nWeak = graph->links[lang * nLangs + i];
+            if (graph->links[i * nLangs + destLang] < nWeak)
+                nWeak = graph->links[i * nLangs + destLang];
+
+            if (i != lang && i != destLang && nWeak > nBest)
+            {
+                *pivot = i;
+                nBest = nWeak;
+            }
+        }
+
+        // the links go both ways, and so does the pivot
+        graph->pivots[destLang * nLangs + lang] = *pivot;
+    }
+
+    return *pivot;
+}
+
+/**
+ * @brief
+ *    Returns the translation of a lang-tl pair in a destination language,
+ *    from any pair of an entry (see findTransId()). If there is none, the
+ *    translation is chained across entries through a pivot language, such
+ *    as Malay to English in one entry and then English to Tagalog in
+ *    another.
+ *
+ * @param dict         The dictionary to be searched.
+ * @param lang         The language ID of the pair.
+ * @param nId          The string ID of the translation of the pair (-1 if
+ *                     it is not in the string pool).
+ * @param destLang     The language ID to be translated to.
+ * @param nPivotLang   The language ID of the pivot (see getPivotLang()), or
+ *                     -1 if there is none.
+ *
+ * @return
+ *    The string ID of the translation   if there is one.
+ *    -1                                 if there is none.
+ */
+int
+translateTerm(Dictionary *dict,
+              int lang,
+              int nId,
+              int destLang,
+              int nPivotLang)
+{
+    int nTrans = -1;
+
+    if (nId != -1)
+        nTrans = findTransId(dict, lang, nId, destLang);
+
+    if (nTrans == -1 && nId != -1 && nPivotLang != -1)
+    {
+        nTrans = findTransId(dict, lang, nId, nPivotLang);
+        if (nTrans != -1)
+            nTrans = findTransId(dict, nPivotLang, nTrans, destLang);
+    }
+
+    return nTrans;
+}
+
+/**
+ * @brief
+ *    Returns the materialized translations from one language to another:
+ *    the string ID of the translation of each string ID (see
+ *    translateTerm()), or -1 if it has none. The least recently used tables
+ *    are dropped to keep within the memory budget.
+ *
+ * @details
+ *    Computing a table costs about a lookup for every string, so a table is
+ *    only made (or brought up to date) once the words looked up without it
+ *    add up to that, and a few words with a large dictionary never pay for
+ *    the whole table. Until then the words are looked up one at a time,
+ *    which at most doubles the lookups compared to knowing in advance how
+ *    many words will come. After that, only the translations marked by
+ *    invalidateTables() are computed again.
+ *
+ * @param dict         The dictionary containing the tables.
+ * @param lang         The language ID of the words.
+ * @param destLang     The language ID to be translated to.
+ * @param nPivotLang   The language ID of the pivot (see getPivotLang()), or
+ *                     -1 if there is none.
+ * @param nLookups     About how many words are about to be looked up.
+ *
+ * @pre   No other thread is using the dictionary. The table can be read by
+ *        any number of threads until the dictionary changes.
+ *
+ * @return
+ *    The translation of each string ID   if the table pays off and fits in
+ *                                        the budget.
+ *    NULL                                if not.
+ */
+int *
+getPairTable(Dictionary *dict,
+             int lang,
+             int destLang,
+             int nPivotLang,
+             size_t nLookups)
+{
+    TableCache *cache = &dict->tables;
+    PairTable *table;
+    Pair *pairs;
+    int nStrings = dict->strings.nStrings;
+    int i, j, nOldCap, nOldest;
+    int nTable = -1;
+    size_t nCost;
+
+    if (lang < 0 || destLang < 0 || nStrings == 0 ||
+        (size_t)nStrings * sizeof(int) > cache->nBudget)
+        return NULL;
+
+    for (i = 0; i < cache->nTables && nTable == -1; i++)
+    {
+        if (cache->tables[i].lang == lang &&
+            cache->tables[i].destLang == destLang)
+            nTable = i;
+    }
+
+    if (nTable == -1)
+    {
+        cache->tables = (PairTable *)growArray(cache->tables,
+                                               &cache->nTableCap,
+                                               cache->nTables + 1,
+                                               sizeof(PairTable));
+        nTable = cache->nTables++;
+        table = &cache->tables[nTable];
+        table->lang = lang;
+        table->destLang = destLang;
+        table->nPivotLang = nPivotLang;
+        table->arrTrans = NULL;
+        table->nIds = 0;
+        table->nIdCap = 0;
+        table->nStale = 0;
+        table->isStale = 1;
+        table->nLookups = 0;
+    }
+
+    table = &cache->tables[nTable];
+    table->nLastUse = ++cache->nClock;
+
+    // a different pivot can chain any of the words differently
+    if (table->nPivotLang != nPivotLang)
+    {
+        table->nPivotLang = nPivotLang;
+        table->isStale = 1;
+    }
+
+    // the words are looked up one at a time until the table pays off
+    nCost = table->isStale ? (size_t)nStrings :
+            (size_t)(table->nStale + nStrings - table->nIds);
+    table->nLookups += nLookups;
+    if (table->nLookups < nCost)
+        return NULL;
+
+    table->nLookups = 0;
+
+    // the strings added since the table was last used are computed too
+    if (table->nIds < nStrings)
+    {
+        nOldCap = table->nIdCap;
+        table->arrTrans = (int *)growArray(table->arrTrans, &table->nIdCap,
+                                           nStrings, sizeof(int));
+        cache->nUsed += (size_t)(table->nIdCap - nOldCap) * sizeof(int);
+        for (i = table->nIds; i < nStrings; i++)
+        {
+            table->arrTrans[i] = -2;
+        }
+
+        table->nStale += nStrings - table->nIds;
+        table->nIds = nStrings;
+    }
+
+    // only the strings of pairs of the language can have translations
+    if (table->isStale)
+    {
+        for (i = 0; i < table->nIds; i++)
+        {
+            table->arrTrans[i] = -1;
+        }
+
+        table->nStale = 0;
+        for (i = 0; i < dict->nEntries; i++)
+        {
+            pairs = getPair(dict, i, 0);
+            for (j = 0; j < dict->entries[i].count; j++)
+            {
+                if (pairs[j].lang == lang &&
+                    table->arrTrans[pairs[j].trans] == -1)
+                {
+                    table->arrTrans[pairs[j].trans] = -2;
+                    table->nStale++;
+                }
+            }
+        }
+
+        table->isStale = 0;
+    }
+
+    // compute every translation now, so that the table is only ever read
+    for (i = 0; i < table->nIds && table->nStale > 0; i++)
+    {
+        if (table->arrTrans[i] == -2)
+        {
+            table->arrTrans[i] = translateTerm(dict, lang, i, destLang,
+                                               nPivotLang);
+            table->nStale--;
+        }
+    }
+
+    // drop the least recently used of the other tables until all fit
+    while (cache->nUsed > cache->nBudget && cache->nTables > 1)
+    {
+        nOldest = nTable == 0 ? 1 : 0;
+        for (i = 0; i < cache->nTables; i++)
+        {
+            if (i != nTable &&
+                cache->tables[i].nLastUse < cache->tables[nOldest].nLastUse)
+                nOldest = i;
+        }
+
+        // the last table is moved to the place of the dropped one
+        dropTable(cache, nOldest);
+        if (nTable == cache->nTables)
+            nTable = nOldest;
+    }
+
+    return cache->tables[nTable].arrTrans;
+}
+
+/**
+ * @brief Initializes an empty dictionary.
+ *
+ * @param dict   The dictionary to be initialized.
+ */
+void
+initDictionary(Dictionary *dict)
+{
+    dict->entries = NULL;
+    dict->srcKeys = NULL;
+    dict->nEntries = 0;
+    dict->nDeleted = 0;
+    dict->nEntryCap = 0;
+    dict->pairs = NULL;
+    dict->nPairs = 0;
+    dict->nPairCap = 0;
+    initStrings(&dict->langs);
+    initStrings(&dict->strings);
+    initIndex(&dict->index);
+    initPostings(&dict->postings);
+    initPhrases(&dict->phrases);
+    initLangGraph(&dict->graph);
+    initTables(&dict->tables, TABLE_BUDGET);
+    initMemory(&dict->memory, MEMORY_LINES);
+    dict->order = NULL;
+    dict->nOrderCap = 0;
+    dict->live = NULL;
+    dict->nLiveCap = 0;
+    dict->isNumbered = 0;
+    dict->firstLang = copyString(DEFAULT_FIRST_LANG,
+                                 strlen(DEFAULT_FIRST_LANG));
+    dict->isArranged = 1; // an empty dictionary is already arranged
+    dict->mapped = NULL;
+    dict->nMapped = 0;
+    dict->exporting = NULL;
+    dict->journal = NULL;
+    dict->nGeneration = 0;
+}
+
+/**
+ * @brief Frees the memory used by a dictionary.
+ *
+ * @param dict   The dictionary to be freed.
+ */
+void
+freeDictionary(Dictionary *dict)
+{
+    // an export in the background keeps its report (see reportExport())
+    waitForExport(dict);
+
+    // the arrays of a snapshot are part of its mapping
+    if (dict->mapped != NULL)
+    {
+        munmap(dict->mapped, dict->nMapped);
+    }
+    else
+    {
+        free(dict->entries);
+        free(dict->srcKeys);
+        free(dict->pairs);
+        freeStrings(&dict->langs);
+        freeStrings(&dict->strings);
+        freeIndex(&dict->index);
+        freePostings(&dict->postings);
+        freePhrases(&dict->phrases);
+    }
+
+    freeLangGraph(&dict->graph);
+    freeTables(&dict->tables);
+    freeMemory(&dict->memory);
+    free(dict->order);
+    free(dict->live);
+    free(dict->firstLang);
+}
+
+/**
+ * @brief
+ *    Sets the language whose entries are arranged first when displaying
+ *    the entries (see arrangeInterEnt()).
+ *
+ * @param dict   The dictionary to be configured.
+ * @param lang   The name of the language (in title case).
+ */
+void
+setFirstLang(Dictionary *dict,
+             char *lang)
+{
+    if (strcmp(dict->firstLang, lang))
+    {
+        beginChange(dict);
+        recordChange(dict, JOURNAL_FIRST_LANG, 0, 0, lang, NULL);
+        free(dict->firstLang);
+        dict->firstLang = copyString(lang, strlen(lang));
+        dict->isArranged = 0;
+    }
+}
+
+/**
+ * @brief
+ *    Appends a new empty entry to the dictionary. It is not added to the
+ *    word index until it has its "source" pair.
+ *
+ * @param dict   The dictionary where the entry will be added.
+ *
+ * @return Returns the index of the new entry.
+ */
+int
+newEntry(Dictionary *dict)
+{
+    Entry *added;
+    SourceKey *key;
+    int nKeyCap;
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_NEW_ENTRY, 0, 0, NULL, NULL);
+    nKeyCap = dict->nEntryCap;
+
+    // the entries and their source keys always have the same capacity
+    dict->entries = (Entry *)growArray(dict->entries, &dict->nEntryCap,
+                                       dict->nEntries + 1, sizeof(Entry));
+    dict->srcKeys = (SourceKey *)growArray(dict->srcKeys, &nKeyCap,
+                                           dict->nEntryCap,
+                                           sizeof(SourceKey));
+
+    // the entry starts at the end of the pair pool so that its first pairs
+    // can be appended in place
+    added = &dict->entries[dict->nEntries];
+    added->offset = dict->nPairs;
+    added->count = 0;
+    added->capacity = 0;
+
+    key = &dict->srcKeys[dict->nEntries];
+    key->lang = -1;
+    key->trans = -1;
+    key->offset = added->offset;
+
+    return dict->nEntries++;
+}
+
+/**
+ * @brief
+ *    Makes sure that an entry has room for one more language-translation
+ *    pair. If the entry is at the end of the pair pool, it simply grows in
+ *    place. Otherwise, its pairs are moved to the end of the pair pool with
+ *    twice the capacity, and the slots it used before are left unused.
+ *
+ * @param dict     The dictionary containing the entry.
+ * @param nEntry   The index of the entry.
+ */
+void
+reservePair(Dictionary *dict,
+            int nEntry)
+{
+    Entry *target = &dict->entries[nEntry];
+    int newCapacity;
+
+    if (target->count < target->capacity)
+        return;
+
+    if (target->offset + target->capacity == dict->nPairs)
+    {
+        // the entry is the last block of the pool
+        dict->pairs = (Pair *)growArray(dict->pairs, &dict->nPairCap,
+                                        dict->nPairs + 1, sizeof(Pair));
+        target->capacity++;
+        dict->nPairs++;
+    }
+    else
+    {
+        newCapacity = target->capacity * 2;
+        dict->pairs = (Pair *)growArray(dict->pairs, &dict->nPairCap,
+                                        dict->nPairs + newCapacity,
+                                        sizeof(Pair));
+        memcpy(&dict->pairs[dict->nPairs], &dict->pairs[target->offset],
+               target->count * sizeof(Pair));
+        target->offset = dict->nPairs;
+        target->capacity = newCapacity;
+        dict->nPairs += newCapacity;
+        dict->srcKeys[nEntry].offset = target->offset;
+    }
+}
+
+/**
+ * @brief
+ *    Updates the source key of an entry from its "source" pair. This must be
+ *    called whenever the "source" pair of an entry is assigned.
+ *
+ * @param dict     The dictionary containing the entry.
+ * @param nEntry   The index of the entry.
+ *
+ * @pre   The entry has at least one language-translation pair.
+ */
+void
+setSourceKey(Dictionary *dict,
+             int nEntry)
+{
+    SourceKey *key = &dict->srcKeys[nEntry];
+    Pair *source = getPair(dict, nEntry, 0);
+
+    key->lang = source->lang;
+    key->trans = source->trans;
+    key->offset = dict->entries[nEntry].offset;
+}
+
+/**
+ * @brief
+ *    This function displays the divider for better readability in the
+ *    runtime.
+ */
+void
+displayDivider()
+{
+    printf("\n");
+    for (int i = 0; i < 100; i++)
+    {
+        printf("-");
+    }
+    printf("\n\n");
+}
+
+/**
+ * @brief This function displays the Main Menu to the user.
+ *
+ */
+void
+displayMainMenu()
+{
+    displayDivider();
+
+    char menuText[] = "MAIN MENU\n"
+                      "1 - Manage Data\n"
+                      "2 - Translate Menu\n"
+                      "3 - Exit";
+
+    printf("%s", menuText);
+}
+
+/**
+ * @brief This function displays the Translate Menu to the user.
+ *
+ */
+void
+displayTransMenu()
+{
+    displayDivider();
+
+    char menuText[] = "TRANSLATE MENU\n"
+                      "1 - Translate\n"
+                      "2 - Exit";
+
+    printf("%s", menuText);
+}
+
+/**
+ * @brief
+ *    This function asks the user to choose from the given choices of the
+ *    Main Menu.
+ *
+ * @param pMainChoice   The address where the user's choice will be stored.
+ */
+void
+getMainChoice(int *pMainChoice)
+{
+    printf("\n\nEnter a number from 1 to 3.\n");
+    *pMainChoice = getIntInput(1, 3);
+}
+
+/**
+ * @brief
+ *    This function asks the user to choose from the given choices of the
+ *    Translate Menu.
+ *
+ * @param pTransChoice   The address where the user's choice will be stored.
+ */
+void
+getTransChoice(int *pTransChoice)
+{
+    printf("\n\nEnter a number from 1 to 2.\n");
+    *pTransChoice = getIntInput(1, 2);
+}
+
+/**
+ * @brief This function displays the Manage Data Menu to the user.
+ *
+ */
+void
+displayManageMenu()
+{
+    displayDivider();
+
+    char menuText[] = "MANAGE DATA MENU\n"
+                      "1 - Add Entry\t\t\t6 - Search Word\n"
+                      "2 - Add Translation\t\t7 - Search Translation\n"
+                      "3 - Delete Entry\t\t8 - Export\n"
+                      "4 - Delete Translation\t\t9 - Import\n"
+                      "5 - Display All Entries\t\t10 - Exit";
+
+    printf("%s", menuText);
+}
+
+/**
+ * @brief
+ *     This function asks the user to choose from the given choices of the
+ *     Manage Data Menu.
+ *
+ * @param pManageChoice   The address where the user's choice will be stored.
+ */
+void
+getManageChoice(int *pManageChoice)
+{
+    printf("\n\nEnter a number from 1 to 10.\n");
+    *pManageChoice = getIntInput(1, 10);
+}
+
+/**
+ * @brief
+ *    This function gets the Language and Translation pair input from the
+ *    user. Necessary code to handle invalid inputs were also in place.
+ *
+ * @param pTempLangVar    The address where the language input is stored,
+ *                        which must be freed by the caller.
+ * @param pTempTransVar   The address where the translation input is stored,
+ *                        which must be freed by the caller.
+ */
+void
+getLangTrans(char **pTempLangVar, 
+             char **pTempTransVar)
+{
+    displayDivider();
+
+    // get language
+    printf("Enter language.\n");
+    *pTempLangVar = getLineInput(MIN_LANG_LEN);
+    titleCase(*pTempLangVar);
+
+    // get translation
+    printf("Enter translation.\n");
+    *pTempTransVar = getLineInput(MIN_TL_LEN);
+    lowercase(*pTempTransVar);
+}
+
+/**
+ * @brief
+ *    This function obtains a command of either next, previous, or exit as the
+ *    choice of the user when entries are being displayed.
+ *
+ * @param pDispChoice   The address where the user's command (a char) will be
+ *                      stored.
+ * @param nIndex        The index of an array.
+ * @param nEntryCount   The current number entries in the entry list.
+ *
+ * @pre   nIndex is >= 0 and <= nEntryCount - 1.
+ */
+void
+getDispChoice(char *pDispChoice, 
+              int nIndex, 
+              int nEntryCount)
+{
+    // display menu options
+    printf("\n\nYour possible options from here:\n");
+    if (nIndex > 0)
+    {
+        printf("%c - Previous\n", ENTRY_OPTION_PREV);
+    }
+
+    if (nEntryCount > 1 && nIndex <= nEntryCount - 2)
+    {
+        printf("%c - Next\n", ENTRY_OPTION_NEXT);
+    }
+
+    printf("%c - Exit\n", ENTRY_OPTION_EXIT);
+
+    // get actual choice from user
+    int inputIsValid = 0;
+
+    while (!inputIsValid)
+    {
+        *pDispChoice = getCharInput();
+
+        // the char obtained is converted to uppercase so it does not
+        // need to be checked with two chars every time
+        *pDispChoice = toupper(*pDispChoice);
+
+        if ((*pDispChoice == ENTRY_OPTION_PREV && nIndex > 0) ||
+            (*pDispChoice == ENTRY_OPTION_NEXT && nEntryCount > 1 &&
+             nIndex <= nEntryCount - 2) ||
+            (*pDispChoice == ENTRY_OPTION_EXIT))
+        {
+            inputIsValid = 1;
+        }
+    }
+}
+
+/**
+ * @brief This function displays one entry to the user.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nIndex          The index of an array.
+ * @param nManageChoice   The integer representing the user's choice in the
+ *                        Manage Data Menu.
+ *
+ * @pre   nIndex should only be an integer ranging from 0 to array size - 1.
+ */
+void
+displayCurrent(Dictionary *dict, 
+               int nIndex, 
+               int nManageChoice)
+{
+    int i;
+    Pair *pairs = getPair(dict, nIndex, 0);
+
+    // display header if displaying entry one at a time
+    if (nManageChoice != 1 && nManageChoice != 2)
+    {
+        displayDivider();
+        printf("Format (Language: Translation)\n");
+    }
+
+    printf("\nEntry No. %d", getEntryNumber(dict, nIndex) + 1);
+
+    // print language-translation pairs
+    for (i = 0; i < dict->entries[nIndex].count; i++)
+    {
+        printf("\n(%d) %s: %s", i + 1, getLangName(dict, pairs[i].lang),
+                                       getTrans(dict, &pairs[i]));
+    }
+
+    printf("\n");
+}
+
+/**
+ * @brief This function displays to the user all matched entries found.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param arrMatched      The array where the indices of the matched entries
+                          are stored.
+ * @param nMatches        The number of matched entries found in the search.
+ * @param nManageChoice   The integer representing the user's choice in the
+ *                        Manage Data Menu.
+ *
+ * @pre   nMatches is >= 1 and <= dict->nEntries.
+ */
+void
+displayMEntries(Dictionary *dict,
+                int *arrMatched,
+                int nMatches,
+                int nManageChoice)
+{
+    int i, k = 0;
+    char cDispChoice;
+
+    displayDivider();
+
+    if (nMatches == 1)
+    {
+        printf("There is %d matched entry ", nMatches);
+    }
+    else
+    {
+        printf("There are %d matched entries ", nMatches);
+    }
+
+    printf("that contain%s the ", nMatches == 1 ? "s" : "");
+
+    if (nManageChoice == 1 || nManageChoice == 2 || nManageChoice == 7)
+        printf("language-translation pair.\n");
+    else
+        printf("searched word.\n");
+
+    if (nManageChoice == 1 || nManageChoice == 2)
+    {
+        displayDivider();
+        printf("Format (Language: Translation)\n");
+        for (i = 0; i < nMatches; i++)
+        {
+            displayCurrent(dict, arrMatched[i], nManageChoice);
+        }
+    }
+    else
+    {
+        while (k >= 0 && k < nMatches)
+        {
+            displayCurrent(dict, arrMatched[k], nManageChoice);
+            getDispChoice(&cDispChoice, k, nMatches);
+
+            switch (cDispChoice)
+            {
+                case ENTRY_OPTION_NEXT:
+                    k++;
+                    break;
+                case ENTRY_OPTION_PREV:
+                    k--;
+                    break;
+                default:
+                    k = nMatches;
+                    break; // exit
+            }
+        }
+    }
+}
+
+/**
+ * @brief Asks confirmation from the user.
+ *
+ * @return
+ *    1   if the user answers 'yes'.
+ *    0   if the user answers 'no'.
+ */
+int
+getUserConfirmation()
+{
+    int confirm = 0;
+    int inputIsValid = 0;
+    char input = 0;
+
+    printf("[Y/N] \n");
+    while (!inputIsValid)
+    {
+        input = getCharInput();
+        input = tolower(input); // to avoid checking with two chars every time
+        if (input == CONFIRM_YES || input == CONFIRM_NO)
+        {
+            inputIsValid = 1;
+        }
+    }
+
+    switch (input)
+    {
+        case CONFIRM_YES:
+            confirm = 1;
+            break;
+        case CONFIRM_NO:
+            confirm = 0;
+            break;
+    }
+
+    return confirm;
+}
+
+/**
+ * @brief This function asks the user if the entry is for a new entry or not.
+ *
+ * @return
+ *    1   if it is for a new entry (the user answered 'yes').
+ *    0   if it is not for a new entry (the user answered 'no').
+ */
+int
+isNewEntry()
+{
+    displayDivider();
+
+    printf("Is this for a new entry? ");
+    return getUserConfirmation();
+}
+
+/**
+ * @brief
+ *    This function assigns the new entries from the temporary variables to
+ *    the actual array of entries. The first pair of an entry is its "source"
+ *    pair, and every other pair is inserted after the pairs whose language
+ *    is alphabetically before or the same as its own, so the pairs after the
+ *    "source" pair are always sorted by language.
+ *
+ * @param dict           The dictionary containing all the entries and
+ *                       language-translation pairs.
+ * @param nEntryCount    The index of the entry where the pair is added.
+ * @param tempLangVar    The string where the language input is temporarily
+ *                       stored.
+ * @param tempTransVar   The string where the translation input is temporarily
+ *                       stored.
+ *
+ * @pre   nEntryCount is >= 0 and < dict->nEntries.
+ */
+void
+assignNewEntries(Dictionary *dict,
+                 int nEntryCount,
+                 char *tempLangVar,
+                 char *tempTransVar)
+{
+    Pair *pairs;
+    int i, nLang;
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_ADD_PAIR, nEntryCount, 0, tempLangVar,
+                 tempTransVar);
+
+    // the locations of the pairs after the new one are about to change
+    if (isEntryIndexed(dict, nEntryCount))
+        unindexWords(dict, nEntryCount);
+
+    // make room for the new pair at the end of the entry
+    reservePair(dict, nEntryCount);
+    pairs = getPair(dict, nEntryCount, 0);
+    nLang = internLang(&dict->langs, tempLangVar);
+
+    // shift the pairs with a later language back (the "source" pair at
+    // index 0 stays where it is)
+    i = dict->entries[nEntryCount].count;
+    while (i > 1 && strcmp(getLangName(dict, pairs[i - 1].lang),
+                           tempLangVar) > 0)
+    {
+        pairs[i] = pairs[i - 1];
+        i--;
+    }
+
+    pairs[i].lang = nLang;
+    pairs[i].len = strlen(tempTransVar);
+    pairs[i].trans = internString(&dict->strings, tempTransVar,
+                                  pairs[i].len);
+
+    dict->entries[nEntryCount].count++;
+    dict->isArranged = 0;
+
+    if (dict->entries[nEntryCount].count == 1)
+        setSourceKey(dict, nEntryCount);
+
+    if (isEntryIndexed(dict, nEntryCount))
+    {
+        indexPhrases(dict, nEntryCount);
+        indexWords(dict, nEntryCount);
+    }
+}
+
+/**
+ * @brief
+ *    This function asks the user for more language-translation pairs to add
+ *    under the same entry until the user no longer wants to add pairs.
+ *
+ * @param dict          The dictionary containing all the entries and
+ *                      language-translation pairs.
+ * @param nEntryCount   The index of the entry where the pairs are added.
+ *
+ * @pre   nEntryCount is >= 0 and < dict->nEntries.
+ */
+void
+addMoreTrans(Dictionary *dict, 
+             int nEntryCount, 
+             int nManageChoice)
+{
+    char *tempLangVar, *tempTransVar;
+
+    int over = 0;
+    while (!over)
+    {
+        if (dict->entries[nEntryCount].count > 1)
+        {
+            displayDivider();
+            printf("Do you want to add more language-translation pairs ");
+            printf("for this entry? ");
+            over = !getUserConfirmation();
+        }
+
+        if (!over)
+        {
+            // if the user chooses yes or there are < 2 language-translation
+            // pairs in the entry
+            getLangTrans(&tempLangVar, &tempTransVar);
+            assignNewEntries(dict, nEntryCount, tempLangVar, tempTransVar);
+            free(tempLangVar);
+            free(tempTransVar);
+            displayDivider();
+            printf("Format (Language: Translation)\n");
+            displayCurrent(dict, nEntryCount, nManageChoice);
+        }
+        else
+        {
+            // if the user chooses no
+            displayDivider();
+            printf("Going back to the Manage Data Menu now...\n");
+        }
+    }
+}
+
+/**
+ * @brief
+ *    This function handles the display message when the user tries to use a
+ *    feature that requires at least one entry, when there is no entry added
+ *    yet.
+ *
+ * @param nManageChoice The user's choice in the Manage Data menu.
+ *
+ * @pre   nManageChoice is >= 2 and <= 8.
+ */
+void
+displayNoneMsg(int nManageChoice)
+{
+    displayDivider();
+
+    switch (nManageChoice)
+    {
+        case 2:
+            printf("This entry does not exist. ");
+            printf("You must first utilize the Add Entry feature.\n");
+            break;
+        case 3:
+        case 4:
+            printf("There are no entries yet. ");
+            printf("Hence, you can't delete anything for now.\n");
+            break;
+        case 5:
+            printf("There are no entries to display yet.\n");
+            break;
+        case 6:
+            printf("There are no entries that contain this word.\n");
+            break;
+        case 7:
+            printf("This language-translation pair does not exist.\n");
+            break;
+        case 8:
+            printf("There is no data to export yet.\n");
+            break;
+    }
+}
+
+/**
+ * @brief This function asks the user which entry does he or she wants to add
+ * the pair into.
+ *
+ * @param nEntryChoice   The address where the user's choice will be stored.
+ * @param arrMatched     The array where the indices of the matched entries
+ *                       are stored.
+ * @param nMatches       The number of matched entries found in the search.
+ *
+ * @pre   nMatches is >= 1 and <= the amount of entries.
+ */
+void
+getEntryChoice(int *nEntryChoice, 
+               int *arrMatched, 
+               int nMatches)
+{
+    int nChoice;
+
+    displayDivider();
+    printf("Which entry do you want to add a language-translation pair?\n");
+    nChoice = getIntInput(1, nMatches);
+
+    // assign the index of the entry to the user's choice variable
+    *nEntryChoice = arrMatched[nChoice - 1];
+}
+
+/**
+ * @brief This function checks if the language input is in the specific entry.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nLang           The ID of the tested language.
+ * @param nCurrentEntry   The index of the entry being tested.
+ *
+ * @pre   nCurrentEntry is >= 0 and <= dict->nEntries - 1.
+ *
+ * @return
+ *    1   if the language is in the entry.
+ *    0   if not.
+ */
+int
+isLangInEntry(Dictionary *dict, 
+              int nLang,
+              int nCurrentEntry)
+{
+    int i, nReturn = 0;
+    Pair *pairs = getPair(dict, nCurrentEntry, 0);
+
+    // look for the language within the entry (intra-entry)
+    for (i = 0; i < dict->entries[nCurrentEntry].count && nReturn == 0; i++)
+    {
+        if (pairs[i].lang == nLang)
+        {
+            nReturn = 1;
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    Removes the deleted entries (see deleteEntry()) from the dictionary in
+ *    a single pass. The entries that are left keep their order, and their
+ *    pairs are packed into a new pair pool without the unused slots (and
+ *    their translations into a new string pool the same way, which gives
+ *    them new string IDs). The word index is chained again from the source
+ *    keys, and the locations of the posting index are renumbered and packed
+ *    into a new posting pool, so no index has to be rebuilt from the
+ *    translations.
+ *    Nothing is done if no entry is deleted.
+ *
+ * @param dict   The dictionary to be compacted.
+ *
+ * @pre   Every entry is indexed.
+ */
+void
+compactEntries(Dictionary *dict)
+{
+    WordIndex *index = &dict->index;
+    PostingIndex *postings = &dict->postings;
+    Posting *locations, *pool;
+    Pair *pairs = NULL;
+    StringPool strings;
+    WordPostings *words;
+    SourceKey *key;
+    int *newIndex, *newIds;
+    int i, j, k, count, nBucket;
+    int nLive = 0, nLivePairs = 0, nPairCap = 0, nPool;
+
+    if (dict->nDeleted == 0)
+        return;
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_COMPACT, 0, 0, NULL, NULL);
+
+    // the string IDs are numbered again, so the tables no longer apply
+    clearTables(&dict->tables);
+
+    // number the entries that are left (-1 for the deleted ones)
+    dict->order = (int *)growArray(dict->order, &dict->nOrderCap,
+                                   dict->nEntries, sizeof(int));
+    newIndex = dict->order;
+    for (i = 0; i < dict->nEntries; i++)
+    {
+        newIndex[i] = isEntryDeleted(dict, i) ? -1 : nLive++;
+        nLivePairs += dict->entries[i].count;
+    }
+
+    // the new string ID of each old one (-1 if no pair uses it anymore)
+    newIds = (int *)malloc((dict->strings.nStrings + 1) * sizeof(int));
+    if (newIds == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < dict->strings.nStrings; i++)
+    {
+        newIds[i] = -1;
+    }
+
+    // move each entry down to its new index, packing its pairs and the
+    // translations they still use
+    pairs = (Pair *)growArray(pairs, &nPairCap, nLivePairs, sizeof(Pair));
+    initStrings(&strings);
+    nLivePairs = 0;
+    for (i = 0; i < dict->nEntries; i++)
+    {
+        j = newIndex[i];
+        count = dict->entries[i].count;
+        if (j != -1)
+        {
+            memcpy(&pairs[nLivePairs], getPair(dict, i, 0),
+                   count * sizeof(Pair));
+            for (k = nLivePairs; k < nLivePairs + count; k++)
+            {
+                if (newIds[pairs[k].trans] == -1)
+                    newIds[pairs[k].trans] =
+                        internString(&strings, getTrans(dict, &pairs[k]),
+                                     pairs[k].len);
+
+                pairs[k].trans = newIds[pairs[k].trans];
+            }
+
+            dict->entries[j].offset = nLivePairs;
+            dict->entries[j].count = count;
+            dict->entries[j].capacity = count;
+            dict->srcKeys[j] = dict->srcKeys[i];
+            dict->srcKeys[j].offset = nLivePairs;
+            dict->srcKeys[j].trans = pairs[nLivePairs].trans;
+            nLivePairs += count;
+        }
+    }
+
+    free(dict->pairs);
+    dict->pairs = pairs;
+    dict->nPairs = nLivePairs;
+    dict->nPairCap = nPairCap;
+    freeStrings(&dict->strings);
+    dict->strings = strings;
+
+    // chain the entries again in the same order as rebuildIndex() does
+    for (i = 0; i < index->nBuckets; i++)
+    {
+        index->heads[i] = -1;
+    }
+
+    for (i = 0; i < nLive; i++)
+    {
+        key = &dict->srcKeys[i];
+        nBucket = hashLangTLPair(key->lang, (unsigned int)key->trans) &
+                  (index->nBuckets - 1);
+        index->next[i] = index->heads[nBucket];
+        index->heads[nBucket] = i;
+    }
+
+    index->nIndexed = nLive;
+
+    // the locations of a deleted entry were already removed, and the new
+    // indices keep the locations sorted; the locations of each string that
+    // is left are packed into a new posting pool under its new ID, which
+    // drops the blocks left behind by lists that were moved to the end of
+    // the pool and by the strings that are no longer used
+    words = (WordPostings *)malloc((strings.nStrings + 1) *
+                                   sizeof(WordPostings));
+    pool = (Posting *)malloc((nLivePairs + 1) * sizeof(Posting));
+    if (words == NULL || pool == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    nPool = 0;
+    for (i = 0; i < postings->nWords; i++)
+    {
+        if (newIds[i] != -1)
+        {
+            locations = getPostings(postings, &postings->words[i]);
+            count = postings->words[i].count;
+            for (j = 0; j < count; j++)
+            {
+                pool[nPool + j].entry = newIndex[locations[j].entry];
+                pool[nPool + j].pair = locations[j].pair;
+            }
+
+            words[newIds[i]].offset = nPool;
+            words[newIds[i]].count = count;
+            words[newIds[i]].capacity = count;
+            nPool += count;
+        }
+    }
+
+    free(postings->pool);
+    postings->pool = pool;
+    postings->nPool = nPool;
+    postings->nPoolCap = nLivePairs + 1;
+    free(postings->words);
+    postings->words = words;
+    postings->nWords = strings.nStrings;
+    postings->nWordCap = strings.nStrings + 1;
+    free(newIds);
+
+    dict->nEntries = nLive;
+    dict->nDeleted = 0;
+}
+
+/**
+ * @brief
+ *    This function arranges the entries by placing entries with the first
+ *    language (dict->firstLang, "English" by default) first, and they are
+ *    arranged based on order of entry. Meanwhile, entries without the first
+ *    language are placed at the end of the entries, also in order of entry.
+ *
+ * @details
+ *    The entries are stably partitioned in a single pass into a permutation
+ *    of their indices, which is then applied in place by following its
+ *    cycles, so each entry is moved at most once.
+ *
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs. Its word index is rebuilt if
+ *               any entries were moved, and only the translations of the
+ *               moved entries are computed again (see invalidateTables()).
+ */
+void
+arrangeInterEnt(Dictionary *dict)
+{
+    int i, j, nNext;
+    int nFirst = 0, nRest = 0;
+    int moved = 0;
+    int nEntryCount = dict->nEntries;
+    int nLang = findLang(&dict->langs, dict->firstLang); // -1 if not used yet
+    int *order;
+    Entry tempEntry;
+    SourceKey tempKey;
+
+    beginChange(dict);
+    dict->order = (int *)growArray(dict->order, &dict->nOrderCap,
+                                   nEntryCount, sizeof(int));
+    order = dict->order;
+
+    // entries with the first language fill the order from the front, while
+    // the rest fill it from the back (in reverse)
+    for (i = 0; i < nEntryCount; i++)
+    {
+        if (nLang != -1 && isLangInEntry(dict, nLang, i))
+            order[nFirst++] = i;
+        else
+            order[nEntryCount - 1 - nRest++] = i;
+    }
+
+    // restore the order of entry of the rest
+    for (i = nFirst, j = nEntryCount - 1; i < j; i++, j--)
+    {
+        nNext = order[i];
+        order[i] = order[j];
+        order[j] = nNext;
+    }
+
+    // move entry order[i] to i, one cycle of the permutation at a time
+    for (i = 0; i < nEntryCount; i++)
+    {
+        if (order[i] != i)
+        {
+            tempEntry = dict->entries[i];
+            tempKey = dict->srcKeys[i];
+
+            j = i;
+            while (order[j] != i)
+            {
+                nNext = order[j];
+                dict->entries[j] = dict->entries[nNext];
+                dict->srcKeys[j] = dict->srcKeys[nNext];
+                invalidateTables(dict, j);
+                order[j] = j;
+                j = nNext;
+            }
+
+            dict->entries[j] = tempEntry;
+            dict->srcKeys[j] = tempKey;
+            invalidateTables(dict, j);
+            order[j] = j;
+            moved = 1;
+        }
+    }
+
+    if (moved)
+        rebuildIndex(dict);
+}
+
+/**
+ * @brief
+ *    Arranges the entries (see arrangeInterEnt()), unless nothing changed
+ *    since the last time they were arranged. The pairs within each entry
+ *    are already kept sorted by assignNewEntries(), and the deleted entries
+ *    are left in place, as they are skipped when the entries are numbered
+ *    (see getEntryIndex()).
+ *
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs.
+ */
+void
+arrangeEntries(Dictionary *dict)
+{
+    if (!dict->isArranged)
+    {
+        recordChange(dict, JOURNAL_ARRANGE, 0, 0, NULL, NULL);
+        arrangeInterEnt(dict);
+        dict->isArranged = 1;
+    }
+}
+
+/**
+ * @brief
+ *    This function displays all entries to the user by displaying each entry
+ *    one at a time.
+ *
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs.
+ */
+void
+displayAllEntries(Dictionary *dict, 
+                  int nManageChoice)
+{
+    int k = 0;
+    int nEntryCount = countEntries(dict);
+    char cDispChoice;
+
+    // arrange the entries inter-entry (those with "English" go first), if
+    // anything changed
+    arrangeEntries(dict);
+
+    // the deleted entries are skipped
+    while (k >= 0 && k < nEntryCount)
+    {
+        displayCurrent(dict, getEntryIndex(dict, k), nManageChoice);
+        getDispChoice(&cDispChoice, k, nEntryCount);
+
+        // adjust the index of the entry being displayed depending on
+        // the user's command
+        switch (cDispChoice)
+        {
+            case ENTRY_OPTION_NEXT:
+                k++;
+                break;
+            case ENTRY_OPTION_PREV:
+                k--;
+                break;
+            default:
+                k = nEntryCount;
+                break; // exit
+        }
+    }
+}
+
+/**
+ * @brief
+ *    This function gets the choice of the user on which entry to delete or
+ *    delete from.
+ *
+ * @param nDelChoice    Address where the user's entry choice to delete is
+ *                      stored.
+ * @param nEntryCount   The current number entries in the entry list.
+ *
+ * @pre *nDelChoice is >= 1 and <= nEntryCount.
+ *
+ * @return
+ *    1   if the user entered a valid input.
+ *    0   if invalid.
+ */
+int
+getDelChoice(int *nDelChoice, 
+             int nEntryCount)
+{
+    int nReturn;
+
+    displayDivider();
+    printf("Enter the entry number.\n");
+    *nDelChoice = getIntInput(INT_MIN, INT_MAX);
+
+    // handle invalid input
+    if ((*nDelChoice) >= 1 && (*nDelChoice) <= nEntryCount)
+        nReturn = 1;
+    else
+        nReturn = 0;
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    This function displays a message to the user that the entered input is
+ *    invalid.
+ *
+ */
+void
+displayInvDel()
+{
+    displayDivider();
+    printf("Input is invalid. Going back to the Manage Data Menu now...\n");
+}
+
+/**
+ * @brief
+ *    This function deletes an entry from the list of entries. The entry is
+ *    only marked as deleted (see isEntryDeleted()) instead of shifting the
+ *    entries after it, and its pairs are left unused in the pair pool; both
+ *    are reclaimed in batches by compactEntries(), which runs once most of
+ *    the entries are deleted or before a snapshot is written. Until then,
+ *    the entries are numbered without the deleted ones (see
+ *    getEntryIndex()).
+ *
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param nDelChoice   The index of the entry number that the user wants to
+ *                     delete subtracted by 1.
+ *
+ * @pre   dict->nEntries is > 0.
+ * @pre   nDelChoice is >= 1 and <= dict->nEntries.
+ * @pre   The entry is indexed and not deleted.
+ */
+void
+deleteEntry(Dictionary *dict, 
+            int nDelChoice)
+{
+    int nEntry = nDelChoice - 1; // since the entries array is 0-based
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_DELETE_ENTRY, nDelChoice, 0, NULL, NULL);
+
+    // with no pairs and no "source" language, the entry is skipped by the
+    // searches, while the word index can keep it in its chain
+    unindexWords(dict, nEntry);
+    dict->entries[nEntry].count = 0;
+    dict->srcKeys[nEntry].lang = -1;
+    dict->nDeleted++;
+
+    if (dict->nDeleted * 2 > dict->nEntries)
+        compactEntries(dict);
+}
+
+/**
+ * @brief
+ *    This function gets the index of the pair from a specific entry that
+ *    the user wants to delete.
+ *
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param nDelIndex    Address where the user's choice of pair within an entry
+ *                     to delete will be stored.
+ * @param nDelChoice   The index of the entry number that the user wants to
+ *                     delete subtracted by 1.
+ *
+ * @pre   nDelChoice is >= 1 and <= dict->nEntries.
+ *
+ * @return
+ *    1   if the user inputs a valid number (1 to the entry's pair count).
+ *    0   otherwise.
+ */
+int
+getDelIndex(Dictionary *dict, 
+            int *nDelIndex, 
+            int nDelChoice)
+{
+    int nReturn;
+
+    int over = 0;
+    while (!over)
+    {
+        over = 1; // assume that the input is valid
+
+        printf("\nWhat language-translation pair do you want to delete?\n");
+        *nDelIndex = getIntInput(INT_MIN, INT_MAX);
+
+        // if input is invalid, ask user if they wish to continue
+        // otherwise, loop will automatically stop
+        // set the following conditions in the if condition:
+        // *nDelIndex < 1; if the user can delete the "source" pair
+        // *nDelIndex < 2; if the user can't delete the "source" pair
+        if (*nDelIndex < 2 || *nDelIndex > dict->entries[nDelChoice - 1].count)
+        {
+            printf("\nInput is invalid. ");
+
+            if (*nDelIndex == 1)
+                printf("You can't delete the \"source\" pair. ");
+
+            printf("Do you still want to delete translation? ");
+            over = !getUserConfirmation();
+        }
+    }
+
+    if ((*nDelIndex) >= 1 &&
+        (*nDelIndex) <= dict->entries[nDelChoice - 1].count)
+        nReturn = 1;
+    else
+        nReturn = 0;
+
+    return nReturn;
+}
+
+/**
+ * @brief This function deletes a language-translation pair from an entry.
+ *
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param nDelChoice   The index of the entry number that the user wants to
+ *                     delete, added by 1.
+ * @param nDelIndex    The index of the language-translation pair that the
+ *                     user wants to delete from an entry, added by 1.
+ *
+ * @pre   nDelChoice is >= 1 and <= dict->nEntries.
+ * @pre   nDelIndex is >= 1 and <= the entry's count.
+ */
+void
+deleteTrans(Dictionary *dict, 
+            int nDelChoice, 
+            int nDelIndex)
+{
+    int i;
+    Pair *pairs;
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_DELETE_PAIR, nDelChoice, nDelIndex, NULL,
+                 NULL);
+    nDelChoice--; // since the entries array is 0-based
+    unindexWords(dict, nDelChoice);
+    pairs = getPair(dict, nDelChoice, 0);
+    for (i = nDelIndex - 1; i < dict->entries[nDelChoice].count - 1; i++)
+    {
+        // immediately start shifting pairs forward until the
+        // last pair is copied
+        pairs[i] = pairs[i + 1];
+    }
+
+    dict->entries[nDelChoice].count--;
+    dict->isArranged = 0;
+    indexWords(dict, nDelChoice);
+}
+
+/**
+ * @brief
+ *    This function displays the message, asking the user if he or she wants
+ *    to delete more language-translation pairs.
+ *
+ */
+void
+displayDelAgain()
+{
+    displayDivider();
+    printf("Do you want to delete more language-translation pairs? ");
+}
+
+/**
+ * @brief
+ *    Returns the index of where a language-translation pair is first found in
+ *    an entry.
+ *
+ * @param dict         The dictionary containing the entry.
+ * @param nEntry       The index of the entry to be searched in.
+ * @param lang         The language ID to be searched for.
+ * @param nId          The string ID of the translation to be searched for.
+ * @param start        Index of first string to be searched.
+ * @param end          Index of last string to be searched.
+ *                     If -1 is passed, until the last string is searched.
+ *
+ * @pre   start is >= 0.
+ * @pre   end is < the amount of language-translation pairs in the entry,
+ *        if end is != -1.
+ * @pre   start is <= end, if end is != -1.
+ *
+ * @return
+ *    Index of first found lang-tl pair   if the lang-tl pair was found.
+ *    -1                                  if the lang-tl pair was not found.
+ */
+int
+isPairInEntry(Dictionary *dict, 
+              int nEntry,
+              int lang, 
+              int nId, 
+              int start, 
+              int end)
+{
+    int i, nReturn = -1;
+    Pair *pairs = getPair(dict, nEntry, 0);
+
+    end = end == -1 ? dict->entries[nEntry].count - 1 : end;
+    for (i = start; i <= end; i++)
+    {
+        if (lang == pairs[i].lang && nId == pairs[i].trans)
+        {
+            nReturn = i; // return the index of where the pair was found
+            i = end + 1; // end the loop
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    This function checks if the given language and translation input is
+ *    already existing in the list of entries.
+ *
+ * @param tempLangVar    The string where the language input is temporarily
+ *                       stored.
+ * @param tempTransVar   The string where the translation input is temporarily
+ *                       stored.
+ * @param dict           The dictionary containing all the entries and
+ *                       language-translation pairs.
+ * @param arrMatched     The array where the indices of the matched entries
+ *                       are stored.
+ * @param pMatches       The address where the number of matched entries will
+ *                       be stored.
+ * @param start          Index of the first pair to be searched in all entries.
+ * @param end            Index of the last pair to be searched in all entries.
+ *                       If -1 is passed, all pairs in each entry are searched.
+ *
+ * @pre   arrMatched can hold at least dict->nEntries indices.
+ * @pre   start is >= 0.
+ * @pre   end is < the amount of language-translation pairs in all entries,
+ *        if end is != -1.
+ * @pre   start is <= end, if end is != -1.
+ *
+ * @return
+ *    1   if the pair is in at least one entry.
+ *    0   if the pair has no matches.
+ */
+int
+findPairInAllEntries(char *tempLangVar,
+                     char *tempTransVar,
+                     Dictionary *dict,
+                     int *arrMatched,
+                     int *pMatches,
+                     int start,
+                     int end)
+{
+    int i, nReturn;
+    int pairIsInEntry;
+    int nLang = findLang(&dict->langs, tempLangVar);
+    int nId = findString(&dict->strings, tempTransVar, strlen(tempTransVar));
+    SourceKey *keys = dict->srcKeys;
+
+    nReturn = 0;   // assume pair is not found in any entries
+    *pMatches = 0; // initial number of matches found
+
+    // a language or translation that is not in its table cannot be in any
+    // entry, and otherwise both are compared as integers
+    if (nId == -1)
+        nLang = -1;
+
+    // when only the "source" pairs are searched, stream through the source
+    // keys instead so that the entries and pairs are only touched on a match
+    if (start == 0 && end == 0)
+    {
+        for (i = 0; i < dict->nEntries && nLang != -1; i++)
+        {
+            if (keys[i].lang == nLang && keys[i].trans == nId)
+            {
+                arrMatched[*pMatches] = i;
+                *pMatches += 1;
+                nReturn = 1;
+            }
+        }
+
+        return nReturn;
+    }
+
+    for (i = 0; i < dict->nEntries && nLang != -1; i++)
+    {
+        pairIsInEntry = isPairInEntry(dict, i, nLang, nId, start, end);
+        if (pairIsInEntry != -1)
+        {
+            arrMatched[*pMatches] = i; // store the index
+            *pMatches += 1;
+            nReturn = 1; // the pair was found in at least one entry
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    Returns the index of where a translation string was first found in an
+ *    entry.
+ *
+ * @param dict         The dictionary containing the entry.
+ * @param nEntry       The index of the entry to be searched in.
+ * @param nId          The string ID of the translation to be searched for.
+ * @param start        Index of first string to be searched in the entry.
+ * @param end          Index of last string to be searched in the entry.
+ *                     If -1 is passed, until the last string is searched.
+ *
+ * @pre   start is >= 0.
+ * @pre   end is < the amount of language-translation pairs in the entry,
+ *        if end is != -1.
+ * @pre   start is <= end, if end is != -1.
+ *
+ * @return
+ *    Index of first found tl string   if the translation was found.
+ *    -1                               if the translation was not found.
+ */
+int
+isWordInEntry(Dictionary *dict, 
+              int nEntry,
+              int nId, 
+              int start, 
+              int end)
+{
+    int i, nReturn = -1;
+    Pair *pairs = getPair(dict, nEntry, 0);
+
+    end = end == -1 ? dict->entries[nEntry].count - 1 : end;
+    for (i = start; i <= end; i++)
+    {
+        if (nId == pairs[i].trans)
+        {
+            nReturn = i; // return the index of where the word was found
+            i = end + 1; // end the loop
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    This function searches for the input word in the list of entries, both
+ *    intra-entry and inter-entry.
+ *
+ * @param dict          The dictionary containing all the entries and
+ *                      language-translation pairs.
+ * @param strKey        The string containing the word being searched.
+ * @param arrMatched    The array where the indices of the matched entries are
+ * stored.
+ * @param pMatches      The address where the number of matched entries will be
+ * stored.
+ * @param start         Index of the first pair to be searched in all entries.
+ * @param end           Index of the last pair to be searched in all entries.
+ *                      If -1 is passed, all pairs in each entry are searched.
+ *
+ * @pre   arrMatched can hold at least dict->nEntries indices.
+ * @pre   start is >= 0.
+ * @pre   end is < the amount of language-translation pairs in all entries,
+ *        if end is != -1.
+ * @pre   start is <= end, if end is != -1.
+ *
+ * @return
+ *    1   if the word is in at least one entry.
+ *    0   if not.
+ */
+int
+findWordInAllEntries(Dictionary *dict,
+                     char *strKey,
+                     int *arrMatched,
+                     int *pMatches,
+                     int start,
+                     int end)
+{
+    int i;
+    int wordIsInEntry;
+    WordPostings *word;
+    Posting *locations;
+    int nId = findString(&dict->strings, strKey,
+                         strlen(strKey)); // -1 if in no entry
+
+    int nReturn = 0; // assume translation was not found in any entry
+    *pMatches = 0;   // initial number of matches found
+
+    // when all the pairs are searched, only the locations of the word are
+    // visited; they are sorted by entry, so each entry is added once
+    if (start == 0 && end == -1)
+    {
+        word = findWord(&dict->postings, nId);
+        for (i = 0; word != NULL && i < word->count; i++)
+        {
+            locations = getPostings(&dict->postings, word);
+            if (*pMatches == 0 ||
+                arrMatched[*pMatches - 1] != locations[i].entry)
+            {
+                arrMatched[*pMatches] = locations[i].entry;
+                *pMatches += 1;
+                nReturn = 1;
+            }
+        }
+
+        return nReturn;
+    }
+
+    for (i = 0; i < dict->nEntries && nId != -1; i++)
+    {
+        wordIsInEntry = isWordInEntry(dict, i, nId, start, end);
+        if (wordIsInEntry != -1)
+        {
+            arrMatched[*pMatches] = i; // store the index
+            *pMatches += 1;
+            nReturn = 1; // the translation was found in at least one entry
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief This function gets the word that the user wants to search for.
+ *
+ * @param pKey   The address where the word being searched is stored, which
+ *               must be freed by the caller.
+ */
+void
+getKey(char **pKey)
+{
+    displayDivider();
+    printf("Enter word.\n");
+
+    *pKey = getLineInput(MIN_TL_LEN);
+    lowercase(*pKey);
+}
+
+/**
+ * @brief This function gets the language input from the user.
+ *
+ * @param pLang   The address where the language input is stored, which
+ *                must be freed by the caller.
+ * @param nType   The type of language that the user is asked (either the
+ *                language of the source text or the language to be
+ *                translated to).
+ *
+ * @pre   nType is either 1 or 2.
+ */
+void
+getLang(char **pLang, 
+        int nType)
+{
+    displayDivider();
+
+    if (nType == 1)
+        printf("Enter language of source text.\n");
+    else
+        printf("Enter language to be translated to.\n");
+
+    *pLang = getLineInput(MIN_LANG_LEN);
+    titleCase(*pLang);
+}
+
+/**
+ * @brief
+ *    This function empties the entry count, the pair pool, the language
+ *    table, and the word index when the user chooses to exit from the
+ *    Manage Data menu or Translate menu. The memory of the dictionary is
+ *    kept so it can be reused.
+ *
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs.
+ */
+void
+emptyEntry(Dictionary *dict)
+{
+    char *firstLang;
+    ExportJob *exporting = dict->exporting;
+    Journal *journal = dict->journal;
+    unsigned int nGeneration = dict->nGeneration;
+    size_t nBudget = dict->tables.nBudget;
+    int nMaxLines = dict->memory.nMaxLines;
+    unsigned long nHits = dict->memory.nHits;
+    unsigned long nMisses = dict->memory.nMisses;
+
+    waitForExport(dict);
+    recordChange(dict, JOURNAL_EMPTY, 0, 0, NULL, NULL);
+
+    // a mapped snapshot is simply let go of instead of being copied
+    if (dict->mapped != NULL)
+    {
+        firstLang = dict->firstLang;
+        dict->firstLang = NULL;
+        freeDictionary(dict);
+        initDictionary(dict);
+        free(dict->firstLang);
+        dict->firstLang = firstLang;
+        dict->exporting = exporting;
+        dict->journal = journal;
+        dict->nGeneration = nGeneration;
+        dict->tables.nBudget = nBudget;
+        dict->memory.nMaxLines = nMaxLines;
+        dict->memory.nHits = nHits;
+        dict->memory.nMisses = nMisses;
+    }
+
+    // reset the entry and pair counts
+    dict->nEntries = 0;
+    dict->nDeleted = 0;
+    dict->nPairs = 0;
+    clearStrings(&dict->langs);
+    clearStrings(&dict->strings);
+    clearIndex(&dict->index);
+    clearPostings(&dict->postings);
+    clearPhrases(&dict->phrases);
+    clearTables(&dict->tables);
+    clearMemory(&dict->memory);
+    dict->graph.isStale = 1;
+    dict->isArranged = 1;
+}
+
+/**
+ * @brief
+ *    Checks if a file name has the extension of a dictionary snapshot
+ *    (".snap") instead of a text file.
+ *
+ * @param filename   The name of the file.
+ *
+ * @return
+ *    1   if it is the name of a snapshot.
+ *    0   if not.
+ */
+int
+isSnapshotFile(char *filename)
+{
+    int len = strlen(filename);
+    int nExtLen = strlen(SNAP_EXT);
+
+    return len > nExtLen && !strcmp(&filename[len - nExtLen], SNAP_EXT);
+}
+
+/**
+ * @brief
+ *    Lists the arrays of a dictionary that make up a snapshot, with the size
+ *    and amount of their elements (see exportSnapshot()).
+ *
+ * @param dict       The dictionary to be described.
+ * @param meta       The settings of the dictionary, which are filled in.
+ * @param sections   The array where the SNAP_SECTIONS sections are stored
+ *                   (without their offsets).
+ * @param arrData    The array where the address of each array is stored.
+ */
+void
+describeSnapshot(Dictionary *dict,
+                 SnapMeta *meta,
+                 SnapSection sections[],
+                 void *arrData[])
+{
+    StringPool *words = &dict->phrases.words;
+    void *data[SNAP_SECTIONS] = {
+        meta, dict->entries, dict->srcKeys, dict->pairs, dict->langs.data,
+        dict->langs.offsets, dict->langs.slots, dict->index.heads,
+        dict->index.next, dict->postings.words, dict->postings.pool,
+        dict->phrases.nodes, dict->phrases.slots, words->data,
+        words->offsets, words->slots, dict->strings.data,
+        dict->strings.offsets, dict->strings.slots, dict->firstLang
+    };
+    size_t sizes[SNAP_SECTIONS] = {
+        sizeof(SnapMeta), sizeof(Entry), sizeof(SourceKey), sizeof(Pair),
+        sizeof(char), sizeof(int), sizeof(int), sizeof(int), sizeof(int),
+        sizeof(WordPostings), sizeof(Posting), sizeof(PhraseNode),
+        sizeof(int), sizeof(char), sizeof(int), sizeof(int), sizeof(char),
+        sizeof(int), sizeof(int), sizeof(char)
+    };
+    int counts[SNAP_SECTIONS] = {
+        1, dict->nEntries, dict->nEntries, dict->nPairs, dict->langs.nUsed,
+        dict->langs.nStrings, dict->langs.nSlots, dict->index.nBuckets,
+        dict->index.nIndexed, dict->postings.nWords, dict->postings.nPool,
+        dict->phrases.nNodes, dict->phrases.nSlots, words->nUsed,
+        words->nStrings, words->nSlots, dict->strings.nUsed,
+        dict->strings.nStrings, dict->strings.nSlots,
+        (int)strlen(dict->firstLang) + 1
+    };
+    int i;
+
+    memset(meta, 0, sizeof(SnapMeta));
+    meta->isArranged = dict->isArranged;
+    meta->nGeneration = dict->nGeneration;
+    meta->nMaxLangLen = dict->langs.nMaxLen;
+    meta->nMaxWordLen = dict->phrases.words.nMaxLen;
+    meta->nMaxLen = dict->strings.nMaxLen;
+
+    for (i = 0; i < SNAP_SECTIONS; i++)
+    {
+        sections[i].id = i;
+        sections[i].elemSize = sizes[i];
+        sections[i].offset = 0;
+        sections[i].count = counts[i];
+        arrData[i] = data[i];
+    }
+}
+
+/**
+ * @brief
+ *    Writes a dictionary to a binary snapshot file, which holds a copy of
+ *    every array of the dictionary, including its lookup indexes, so that it
+ *    can be loaded again without parsing anything (see loadSnapshot()). Each
+ *    array is aligned to SNAP_ALIGN bytes in the file.
+ *
+ * @details
+ *    The snapshot is written to a temporary file that then replaces the
+ *    file, so a dictionary that is still mapped from it is not affected.
+ *    The temporary file is flushed to disk before the rename, and the
+ *    directory after it, so that after a crash the file is either the old
+ *    snapshot or the whole new one.
+ *    The deleted entries are removed first (see compactEntries()), so a
+ *    snapshot never holds any.
+ *
+ * @param dict       The dictionary to be written.
+ * @param filename   The name of the snapshot file.
+ *
+ * @return
+ *    1   if the snapshot was written.
+ *    0   if the file could not be written.
+ */
+int
+exportSnapshot(Dictionary *dict,
+               char *filename)
+{
+    static char zeros[SNAP_ALIGN];
+    SnapHeader header;
+    SnapMeta meta;
+    void *arrData[SNAP_SECTIONS];
+    SnapSection *section;
+    unsigned long long nOffset, nSize;
+    char *tempName;
+    FILE *fp_snap;
+    int i;
+    int isWritten;
+
+    compactEntries(dict);
+
+    memset(&header, 0, sizeof(SnapHeader));
+    memcpy(header.magic, SNAP_MAGIC, sizeof(SNAP_MAGIC));
+    header.version = SNAP_VERSION;
+    header.byteOrder = SNAP_BYTE_ORDER;
+    header.nSections = SNAP_SECTIONS;
+    describeSnapshot(dict, &meta, header.sections, arrData);
+
+    // lay out the sections one after the other
+    nOffset = sizeof(SnapHeader);
+    for (i = 0; i < SNAP_SECTIONS; i++)
+    {
+        section = &header.sections[i];
+        nOffset = (nOffset + SNAP_ALIGN - 1) / SNAP_ALIGN * SNAP_ALIGN;
+        section->offset = nOffset;
+        nOffset += section->count * section->elemSize;
+    }
+
+    tempName = (char *)malloc(strlen(filename) + 5);
+    if (tempName == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    sprintf(tempName, "%s.tmp", filename);
+    fp_snap = fopen(tempName, "wb");
+    isWritten = fp_snap != NULL;
+
+    if (isWritten)
+    {
+        isWritten = fwrite(&header, sizeof(SnapHeader), 1, fp_snap) == 1;
+        nOffset = sizeof(SnapHeader);
+        for (i = 0; i < SNAP_SECTIONS && isWritten; i++)
+        {
+            section = &header.sections[i];
+            nSize = section->count * section->elemSize;
+            if (section->offset > nOffset)
+                isWritten = fwrite(zeros, section->offset - nOffset, 1,
+                                   fp_snap) == 1;
+
+            if (isWritten && nSize > 0)
+                isWritten = fwrite(arrData[i], nSize, 1, fp_snap) == 1;
+
+            nOffset = section->offset + nSize;
+        }
+
+        if (isWritten)
+            isWritten = fflush(fp_snap) == 0 && fsync(fileno(fp_snap)) == 0;
+
+        if (fclose(fp_snap) != 0)
+            isWritten = 0;
+
+        if (isWritten)
+            isWritten = rename(tempName, filename) == 0 &&
+                        syncDirectory(filename);
+        else
+            remove(tempName);
+    }
+
+    free(tempName);
+
+    return isWritten;
+}
+
+/**
+ * @brief Returns the address of a section of a mapped snapshot.
+ *
+ * @param mapped     The contents of the snapshot file.
+ * @param nSection   The section (SNAP_META and so on).
+ *
+ * @return Returns the address of the first element of the section.
+ */
+void *
+getSection(char *mapped,
+           int nSection)
+{
+    return &mapped[((SnapHeader *)mapped)->sections[nSection].offset];
+}
+
+/**
+ * @brief Returns the amount of elements in a section of a mapped snapshot.
+ *
+ * @param mapped     The contents of the snapshot file.
+ * @param nSection   The section (SNAP_META and so on).
+ *
+ * @return Returns the amount of elements.
+ */
+int
+getSectionCount(char *mapped,
+                int nSection)
+{
+    return ((SnapHeader *)mapped)->sections[nSection].count;
+}
+
+/**
+ * @brief
+ *    Checks that the slots of an open addressing hash table of a snapshot
+ *    only hold valid IDs, and that the table is at most half full, as it is
+ *    kept while it is used, so probing it always reaches an empty slot.
+ *
+ * @param slots    The slots of the table.
+ * @param nSlots   The amount of slots.
+ * @param nIds     The amount of IDs the table holds.
+ *
+ * @return
+ *    1   if the table is valid.
+ *    0   if not.
+ */
+int
+isValidSlots(int *slots,
+             int nSlots,
+             int nIds)
+{
+    int i, nUsed = 0;
+    int isValid = nIds <= nSlots / 2;
+
+    for (i = 0; i < nSlots && isValid; i++)
+    {
+        isValid = slots[i] >= -1 && slots[i] < nIds;
+        nUsed += slots[i] != -1;
+    }
+
+    return isValid && nUsed <= nIds;
+}
+
+/**
+ * @brief
+ *    Checks a string pool of a mapped snapshot: every string must start
+ *    after the one before it and end with '\0' where the next one starts,
+ *    so that the length of each string can be trusted (see getStringLen()),
+ *    and the hash table over them must be valid (see isValidSlots()).
+ *
+ * @param mapped     The contents of the snapshot file, whose sections are
+ *                   known to fit in the file.
+ * @param nData      The section of the characters of the pool.
+ * @param nOffsets   The section of the offsets of the strings.
+ * @param nSlots     The section of the hash table of the strings.
+ *
+ * @return
+ *    1   if the string pool is valid.
+ *    0   if not.
+ */
+int
+isValidSnapPool(char *mapped,
+                int nData,
+                int nOffsets,
+                int nSlots)
+{
+    char *data = (char *)getSection(mapped, nData);
+    int *offsets = (int *)getSection(mapped, nOffsets);
+    int nUsed = getSectionCount(mapped, nData);
+    int nStrings = getSectionCount(mapped, nOffsets);
+    int i;
+    int isValid = nStrings == 0 || (offsets[0] == 0 && nUsed > 0 &&
+                                    data[nUsed - 1] == '\0');
+
+    for (i = 1; i < nStrings && isValid; i++)
+    {
+        isValid = offsets[i] > offsets[i - 1] && offsets[i] < nUsed &&
+                  data[offsets[i] - 1] == '\0';
+    }
+
+    return isValid &&
+           isValidSlots((int *)getSection(mapped, nSlots),
+                        getSectionCount(mapped, nSlots), nStrings);
+}
+
+/**
+ * @brief
+ *    Checks the strings of a mapped snapshot: the language names, the words
+ *    of the phrase trie and the translations must be valid string pools
+ *    (see isValidSnapPool()), every node of the phrase trie must have a
+ *    known word, and the hash table of the trie must be valid (see
+ *    isValidSlots()).
+ *
+ * @param mapped   The contents of the snapshot file, whose sections are
+ *                 known to fit in the file.
+ *
+ * @return
+ *    1   if the strings are valid.
+ *    0   if not.
+ */
+int
+isValidSnapStrings(char *mapped)
+{
+    PhraseNode *nodes = (PhraseNode *)getSection(mapped, SNAP_PHRASE_NODES);
+    int nNodes = getSectionCount(mapped, SNAP_PHRASE_NODES);
+    int nWords = getSectionCount(mapped, SNAP_PHRASE_WORD_IDS);
+    int i;
+    int isValid = isValidSnapPool(mapped, SNAP_LANG_NAMES, SNAP_LANG_IDS,
+                                  SNAP_LANG_SLOTS) &&
+                  isValidSnapPool(mapped, SNAP_PHRASE_WORDS,
+                                  SNAP_PHRASE_WORD_IDS,
+                                  SNAP_PHRASE_WORD_SLOTS) &&
+                  isValidSnapPool(mapped, SNAP_STRINGS, SNAP_STRING_IDS,
+                                  SNAP_STRING_SLOTS);
+
+    // the first word of a phrase has a (virtual) root as its parent
+    for (i = 0; i < nNodes && isValid; i++)
+    {
+        isValid = nodes[i].word >= 0 && nodes[i].word < nWords &&
+                  nodes[i].parent != -1 && nodes[i].parent < nNodes;
+    }
+
+    return isValid &&
+           isValidSlots((int *)getSection(mapped, SNAP_PHRASE_SLOTS),
+                        getSectionCount(mapped, SNAP_PHRASE_SLOTS), nNodes);
+}
+
+/**
+ * @brief
+ *    Checks the entries of a mapped snapshot: the pairs of every entry must
+ *    be inside the pair pool, its source key must match its first pair,
+ *    and every pair must have a known language and a translation whose
+ *    length is that of its string in the string pool.
+ *
+ * @param mapped   The contents of the snapshot file, whose strings are
+ *                 known to be valid (see isValidSnapStrings()).
+ *
+ * @return
+ *    1   if the entries are valid.
+ *    0   if not.
+ */
+int
+isValidSnapEntries(char *mapped)
+{
+    Entry *entries = (Entry *)getSection(mapped, SNAP_ENTRIES);
+    SourceKey *srcKeys = (SourceKey *)getSection(mapped, SNAP_SRC_KEYS);
+    Pair *pairs = (Pair *)getSection(mapped, SNAP_PAIRS);
+    int *offsets = (int *)getSection(mapped, SNAP_STRING_IDS);
+    int nEntries = getSectionCount(mapped, SNAP_ENTRIES);
+    int nPairs = getSectionCount(mapped, SNAP_PAIRS);
+    int nLangs = getSectionCount(mapped, SNAP_LANG_IDS);
+    int nStrings = getSectionCount(mapped, SNAP_STRING_IDS);
+    int nUsed = getSectionCount(mapped, SNAP_STRINGS);
+    Entry *entry;
+    Pair *pair;
+    int i, j, nEnd;
+    int isValid = 1;
+
+    // a snapshot has no deleted entries, so every entry has a pair
+    for (i = 0; i < nEntries && isValid; i++)
+    {
+        entry = &entries[i];
+        isValid = entry->count >= 1 && entry->count <= entry->capacity &&
+                  entry->offset >= 0 &&
+                  entry->offset <= nPairs - entry->capacity &&
+                  srcKeys[i].offset == entry->offset &&
+                  srcKeys[i].lang == pairs[entry->offset].lang &&
+                  srcKeys[i].trans == pairs[entry->offset].trans;
+
+        for (j = 0; j < entry->count && isValid; j++)
+        {
+            pair = &pairs[entry->offset + j];
+            isValid = pair->lang >= 0 && pair->lang < nLangs &&
+                      pair->trans >= 0 && pair->trans < nStrings;
+
+            // the string of the translation ends where the next one starts
+            if (isValid)
+            {
+                nEnd = pair->trans + 1 < nStrings ?
+                       offsets[pair->trans + 1] : nUsed;
+                isValid = pair->len == nEnd - offsets[pair->trans] - 1;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+/**
+ * @brief
+ *    Checks the indexes of a mapped snapshot: every chain of the word index
+ *    must only hold indexed entries and end without a cycle, and the
+ *    locations of every string of the posting index must be inside the
+ *    posting pool and point to pairs of the entries.
+ *
+ * @param mapped   The contents of the snapshot file, whose entries are
+ *                 known to be valid (see isValidSnapEntries()).
+ *
+ * @return
+ *    1   if the indexes are valid.
+ *    0   if not.
+ */
+int
+isValidSnapIndexes(char *mapped)
+{
+    Entry *entries = (Entry *)getSection(mapped, SNAP_ENTRIES);
+    int *heads = (int *)getSection(mapped, SNAP_INDEX_HEADS);
+    int *next = (int *)getSection(mapped, SNAP_INDEX_NEXT);
+    WordPostings *words = (WordPostings *)getSection(mapped, SNAP_WORDS);
+    Posting *pool = (Posting *)getSection(mapped, SNAP_POSTINGS);
+    int nBuckets = getSectionCount(mapped, SNAP_INDEX_HEADS);
+    int nIndexed = getSectionCount(mapped, SNAP_INDEX_NEXT);
+    int nWords = getSectionCount(mapped, SNAP_WORDS);
+    int nPool = getSectionCount(mapped, SNAP_POSTINGS);
+    int nEntries = getSectionCount(mapped, SNAP_ENTRIES);
+    WordPostings *word;
+    Posting *posting;
+    int i, j, nEntry;
+    int nSteps = 0;
+    int isValid = nWords <= getSectionCount(mapped, SNAP_STRING_IDS);
+
+    // each indexed entry is in one chain at most, so walking all of them
+    // takes no more steps than there are indexed entries
+    for (i = 0; i < nBuckets && isValid; i++)
+    {
+        nEntry = heads[i];
+        while (nEntry != -1 && isValid)
+        {
+            nSteps++;
+            isValid = nEntry >= 0 && nEntry < nIndexed && nSteps <= nIndexed;
+            if (isValid)
+                nEntry = next[nEntry];
+        }
+    }
+
+    for (i = 0; i < nWords && isValid; i++)
+    {
+        word = &words[i];
+        isValid = word->count >= 0 && word->count <= word->capacity &&
+                  word->offset >= 0 &&
+                  word->offset <= nPool - word->capacity;
+
+        for (j = 0; j < word->count && isValid; j++)
+        {
+            posting = &pool[word->offset + j];
+            isValid = posting->entry >= 0 && posting->entry < nEntries &&
+                      posting->pair >= 0 &&
+                      posting->pair < entries[posting->entry].count;
+        }
+    }
+
+    return isValid;
+}
+
+/**
+ * @brief
+ *    Checks that a mapped file is a snapshot that this program can use:
+ *    its header must match this version and machine, and every section
+ *    must have the expected element size, be aligned, and fit in the file.
+ *    This takes the same time for any size of snapshot, as what is inside
+ *    the sections is only checked by verifySnapshot().
+ *
+ * @param dict     A dictionary, used for the expected element sizes.
+ * @param mapped   The contents of the file.
+ * @param size     The size of the file.
+ *
+ * @return
+ *    1   if the snapshot is valid.
+ *    0   if not.
+ */
+int
+isValidSnapshot(Dictionary *dict,
+                char *mapped,
+                size_t size)
+{
+    SnapHeader *header = (SnapHeader *)mapped;
+    SnapSection expected[SNAP_SECTIONS];
+    SnapSection *section;
+    SnapMeta meta;
+    void *arrData[SNAP_SECTIONS];
+    unsigned long long nSlots;
+    int i;
+    int isValid;
+
+    isValid = size >= sizeof(SnapHeader) &&
+              !memcmp(header->magic, SNAP_MAGIC, sizeof(SNAP_MAGIC)) &&
+              header->version == SNAP_VERSION &&
+              header->byteOrder == SNAP_BYTE_ORDER &&
+              header->nSections == SNAP_SECTIONS;
+
+    describeSnapshot(dict, &meta, expected, arrData);
+    for (i = 0; i < SNAP_SECTIONS && isValid; i++)
+    {
+        section = &header->sections[i];
+        isValid = section->id == (unsigned int)i &&
+                  section->elemSize == expected[i].elemSize &&
+                  section->offset % SNAP_ALIGN == 0 &&
+                  section->offset <= size &&
+                  section->count <= (size - section->offset) /
+                                    section->elemSize &&
+                  section->count <= INT_MAX;
+    }
+
+    // the hash tables must have a power of 2 amount of slots
+    for (i = 0; i < SNAP_SECTIONS && isValid; i++)
+    {
+        if (i == SNAP_LANG_SLOTS || i == SNAP_INDEX_HEADS ||
+            i == SNAP_PHRASE_SLOTS || i == SNAP_PHRASE_WORD_SLOTS ||
+            i == SNAP_STRING_SLOTS)
+        {
+            nSlots = header->sections[i].count;
+            isValid = nSlots > 0 && (nSlots & (nSlots - 1)) == 0;
+        }
+    }
+
+    // the first language must end
+    section = header->sections;
+    isValid = isValid && section[SNAP_META].count == 1 &&
+              section[SNAP_SRC_KEYS].count == section[SNAP_ENTRIES].count &&
+              section[SNAP_INDEX_NEXT].count <= section[SNAP_ENTRIES].count &&
+              section[SNAP_FIRST_LANG].count > 0 &&
+              mapped[section[SNAP_FIRST_LANG].offset +
+                     section[SNAP_FIRST_LANG].count - 1] == '\0';
+
+    return isValid;
+}
+
+/**
+ * @brief
+ *    Points a string pool at its sections of a mapped snapshot (see
+ *    loadSnapshot()).
+ *
+ * @param pool       The string pool.
+ * @param mapped     The contents of the snapshot file.
+ * @param nData      The section of the characters of the pool.
+ * @param nOffsets   The section of the offsets of the strings.
+ * @param nSlots     The section of the hash table of the strings.
+ * @param nMaxLen    The length of the longest string.
+ */
+void
+mapStrings(StringPool *pool,
+           char *mapped,
+           int nData,
+           int nOffsets,
+           int nSlots,
+           int nMaxLen)
+{
+    pool->data = (char *)getSection(mapped, nData);
+    pool->nUsed = getSectionCount(mapped, nData);
+    pool->nCap = pool->nUsed;
+    pool->offsets = (int *)getSection(mapped, nOffsets);
+    pool->nStrings = getSectionCount(mapped, nOffsets);
+    pool->nIdCap = pool->nStrings;
+    pool->slots = (int *)getSection(mapped, nSlots);
+    pool->nSlots = getSectionCount(mapped, nSlots);
+    pool->nMaxLen = nMaxLen;
+}
+
+/**
+ * @brief
+ *    Replaces a dictionary with the one in a snapshot file (see
+ *    exportSnapshot()). The file is mapped into memory and the arrays of the
+ *    dictionary point straight into it, so nothing is parsed or rebuilt and
+ *    the dictionary can be used right away. The mapping is private, and the
+ *    arrays are copied out of it the first time the dictionary is changed
+ *    (see detachSnapshot()). Only the header and the bounds of the sections
+ *    are checked (see isValidSnapshot()); the snapshots written by
+ *    exportSnapshot() are trusted, and verifySnapshot() checks the rest.
+ *
+ * @param dict       The dictionary to be replaced.
+ * @param filename   The name of the snapshot file.
+ *
+ * @return
+ *    1   if the snapshot was loaded.
+ *    0   if the file could not be opened or is not a valid snapshot, in
+ *        which case the dictionary is left as it was.
+ */
+int
+loadSnapshot(Dictionary *dict,
+             char *filename)
+{
+    struct stat info;
+    SnapSection *sections;
+    SnapMeta *meta;
+    char *mapped = MAP_FAILED;
+    size_t size = 0, nBudget;
+    unsigned long nHits, nMisses;
+    int fd, nMaxLines;
+
+    fd = open(filename, O_RDONLY);
+    if (fd == -1)
+        return 0;
+
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        size = info.st_size;
+        mapped = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE, fd, 0);
+    }
+
+    close(fd);
+
+    if (mapped == MAP_FAILED)
+        return 0;
+
+    if (!isValidSnapshot(dict, mapped, size))
+    {
+        munmap(mapped, size);
+        return 0;
+    }
+
+    nBudget = dict->tables.nBudget;
+    nMaxLines = dict->memory.nMaxLines;
+    nHits = dict->memory.nHits;
+    nMisses = dict->memory.nMisses;
+    freeDictionary(dict);
+    initLangGraph(&dict->graph);
+    initTables(&dict->tables, nBudget);
+    initMemory(&dict->memory, nMaxLines);
+    dict->memory.nHits = nHits;
+    dict->memory.nMisses = nMisses;
+
+    sections = ((SnapHeader *)mapped)->sections;
+    meta = (SnapMeta *)&mapped[sections[SNAP_META].offset];
+
+    // every capacity is set to its count, since nothing is free to grow
+    dict->entries = (Entry *)&mapped[sections[SNAP_ENTRIES].offset];
+    dict->srcKeys = (SourceKey *)&mapped[sections[SNAP_SRC_KEYS].offset];
+    dict->nEntries = sections[SNAP_ENTRIES].count;
+    dict->nDeleted = 0;
+    dict->nEntryCap = dict->nEntries;
+    dict->pairs = (Pair *)&mapped[sections[SNAP_PAIRS].offset];
+    dict->nPairs = sections[SNAP_PAIRS].count;
+    dict->nPairCap = dict->nPairs;
+
+    mapStrings(&dict->langs, mapped, SNAP_LANG_NAMES, SNAP_LANG_IDS,
+               SNAP_LANG_SLOTS, meta->nMaxLangLen);
+
+    dict->index.heads = (int *)&mapped[sections[SNAP_INDEX_HEADS].offset];
+    dict->index.nBuckets = sections[SNAP_INDEX_HEADS].count;
+    dict->index.next = (int *)&mapped[sections[SNAP_INDEX_NEXT].offset];
+    dict->index.nSlots = sections[SNAP_INDEX_NEXT].count;
+    dict->index.nIndexed = dict->index.nSlots;
+
+    dict->postings.words =
+        (WordPostings *)&mapped[sections[SNAP_WORDS].offset];
+    dict->postings.nWords = sections[SNAP_WORDS].count;
+    dict->postings.nWordCap = dict->postings.nWords;
+    dict->postings.pool = (Posting *)&mapped[sections[SNAP_POSTINGS].offset];
+    dict->postings.nPool = sections[SNAP_POSTINGS].count;
+    dict->postings.nPoolCap = dict->postings.nPool;
+
+    dict->phrases.nodes =
+        (PhraseNode *)&mapped[sections[SNAP_PHRASE_NODES].offset];
+    dict->phrases.nNodes = sections[SNAP_PHRASE_NODES].count;
+    dict->phrases.nNodeCap = dict->phrases.nNodes;
+    dict->phrases.slots = (int *)&mapped[sections[SNAP_PHRASE_SLOTS].offset];
+    dict->phrases.nSlots = sections[SNAP_PHRASE_SLOTS].count;
+    mapStrings(&dict->phrases.words, mapped, SNAP_PHRASE_WORDS,
+               SNAP_PHRASE_WORD_IDS, SNAP_PHRASE_WORD_SLOTS,
+               meta->nMaxWordLen);
+
+    mapStrings(&dict->strings, mapped, SNAP_STRINGS, SNAP_STRING_IDS,
+               SNAP_STRING_SLOTS, meta->nMaxLen);
+
+    dict->order = NULL;
+    dict->nOrderCap = 0;
+    dict->live = NULL;
+    dict->nLiveCap = 0;
+    dict->isNumbered = 0;
+    dict->firstLang = copyString(&mapped[sections[SNAP_FIRST_LANG].offset],
+                                 sections[SNAP_FIRST_LANG].count - 1);
+    dict->isArranged = meta->isArranged;
+    dict->nGeneration = meta->nGeneration;
+    dict->mapped = mapped;
+    dict->nMapped = size;
+
+    return 1;
+}
+
+/**
+ * @brief
+ *    Checks everything inside a snapshot file, beyond what loadSnapshot()
+ *    checks: every index and offset inside the sections must point inside
+ *    the arrays they refer to, so that a damaged file is found before it is
+ *    used instead of being read out of bounds. This reads the whole file.
+ *
+ * @param filename   The name of the snapshot file.
+ *
+ * @return
+ *    1   if the snapshot is valid.
+ *    0   if the file could not be opened or is not a valid snapshot.
+ */
+int
+verifySnapshot(char *filename)
+{
+    Dictionary dict;
+    int isValid;
+
+    initDictionary(&dict);
+    isValid = loadSnapshot(&dict, filename) &&
+              isValidSnapStrings(dict.mapped) &&
+              isValidSnapEntries(dict.mapped) &&
+              isValidSnapIndexes(dict.mapped);
+    freeDictionary(&dict);
+
+    return isValid;
+}
+
+/**
+ * @brief
+ *    This function checks if the filename input from the user contains the
+ *    text file extension (.txt) or the snapshot extension (.snap).
+ *
+ * @param tempFile   The temporary string variable where the filename input
+ *                   is stored.
+ *
+ * @return
+ *    1   if the extension ".txt" or ".snap" is present.
+ *    0   if not.
+ */
+int
+isExtPresent(String35 tempFile)
+{
+    int nReturn = 0; // assume the extension is not present
+    int len;
+
+    // check if ".txt" is present in the file extension
+    len = strlen(tempFile);
+    if (len >= 5) // min of 1 char for the file name and 4 for the ".txt" part
+        if (!strcmp(&tempFile[len - 4], ".txt"))
+            nReturn = 1;
+
+    if (isSnapshotFile(tempFile))
+        nReturn = 1;
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    This function checks if the filename input from the user contains any of
+ *    the invalid characters in filenames. Invalid characters in filenames
+ *    include: \ / : * ? " < > |
+ *
+ * @param tempFile   The temporary string variable where the filename input is
+ *                   stored.
+ * @return
+ *    1   if there are invalid characters present.
+ *    0   if not.
+ */
+int
+isInvCharPres(String35 tempFile)
+{
+    int i;
+    int nReturn = 0;
+
+    // assume the string does not have any invalid characters
+    // if there is at least one found, immediately exit the loop
+    int len = strlen(tempFile);
+    for (i = 0; i < len && nReturn == 0; i++)
+    {
+        if (tempFile[i] == '\\' || tempFile[i] == '/' || tempFile[i] == ':' ||
+            tempFile[i] == '*' || tempFile[i] == '?' || tempFile[i] == '"' ||
+            tempFile[i] == '<' || tempFile[i] == '>' || tempFile[i] == '|')
+        {
+            nReturn = 1;
+        }
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief This function gets filename input from the user.
+ *
+ * @param filename   The string variable where the filename will be stored.
+ */
+void
+getFileName(String30 filename)
+{
+    String35 tempFile; // temporary filename string
+    int fileExtIsPresent = 0;
+    int hasInvalidChars = 0;
+
+    int over = 0;
+    while (!over)
+    {
+        displayDivider();
+        printf("Enter filename (maximum of 30 characters including ");
+        printf("file extension).\n");
+
+        // guarantees that the string is 5 chars long and <= MAX_FILE_LEN
+        getStrInput(tempFile, 5, MAX_FILE_LEN + 1);
+
+        fileExtIsPresent = isExtPresent(tempFile); // needs to be true
+        hasInvalidChars = isInvCharPres(tempFile); // needs to be false
+
+        if (!fileExtIsPresent)
+        {
+            printf("\nInput has no/incorrect file extension. ");
+            printf("Please include the file extension for text ");
+            printf("files (.txt) or snapshots (.snap).\n");
+        }
+        else if (hasInvalidChars)
+        {
+            printf("\nInput has invalid characters for filenames. ");
+            printf("Filenames should not have these characters:\n");
+            printf("\\ / : * ? \" < > | \n");
+        }
+        else
+        {
+            over = 1;
+        }
+    }
+
+    // assign temporary variable to official variable
+    strcpy(filename, tempFile);
+}
+
+/**
+ * @brief
+ *    This function encompasses the Add Entry Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nManageChoice   The integer of the user's choice in the Manage Data
+ * Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (amount of choices in the
+ *        Manage Data Menu).
+ */
+void
+addEntryFeat(Dictionary *dict, 
+             int nManageChoice)
+{
+    int nMatches;
+    int *arrMatched; // array to store the indices of the matched entries
+    int pairIsInEntry;
+    int addEntry = 1; // assume that there will be no matches later
+    int nEntry;
+    char *tempLangVar, *tempTransVar;
+
+    arrMatched = (int *)malloc((dict->nEntries + 1) * sizeof(int));
+
+    // obtain "source" language-translation pair from the user
+    getLangTrans(&tempLangVar, &tempTransVar);
+
+    // find pair only in the "source" language-translation pairs of entries
+    pairIsInEntry = findPairInAllEntries(tempLangVar, tempTransVar, dict,
+                                         arrMatched, &nMatches, 0, 0);
+
+    if (pairIsInEntry)
+    {
+        displayMEntries(dict, arrMatched, nMatches, nManageChoice);
+
+        // ask the user if they want to create a new entry
+        addEntry = isNewEntry();
+    }
+
+    // create an entry if there were no matching entries earlier or
+    // if there were, the user chose to create another one
+    if (addEntry)
+    {
+        // add the lang-trans pair earlier as the "source" pair
+        nEntry = newEntry(dict);
+        assignNewEntries(dict, nEntry, tempLangVar, tempTransVar);
+        displayDivider();
+        printf("Format (Language: Translation)\n");
+        displayCurrent(dict, nEntry, nManageChoice);
+
+        // user must enter at least one "dest/target" language-translation pair
+        // after that, the user may or may not enter more language-translation
+        // pairs
+        addMoreTrans(dict, nEntry, nManageChoice);
+        indexEntry(dict, nEntry);
+    }
+
+    free(tempLangVar);
+    free(tempTransVar);
+    free(arrMatched);
+}
+
+/**
+ * @brief
+ *    This function encompasses the Add Translation Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nManageChoice   The integer of the user's choice in the
+ *                        Manage Data Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
+ *        Manage Data Menu).
+ */
+void
+addTransFeat(Dictionary *dict, 
+             int nManageChoice)
+{
+    int nEntryChoice, nMatches;
+    int *arrMatched; // array to store the indices of the matched entries
+    char *tempLangVar, *tempTransVar;
+    int pairIsInEntry;
+
+    arrMatched = (int *)malloc((dict->nEntries + 1) * sizeof(int));
+
+    // obtain "source" lang-trans pair to be searched
+    getLangTrans(&tempLangVar, &tempTransVar);
+
+    // find pair only in the "source" language-translation pairs of entries
+    pairIsInEntry = findPairInAllEntries(tempLangVar, tempTransVar, dict,
+                                         arrMatched, &nMatches, 0, 0);
+    free(tempLangVar);
+    free(tempTransVar);
+
+    // exit immediately if there are no matches
+    if (!pairIsInEntry)
+    {
+        displayNoneMsg(nManageChoice);
+        free(arrMatched);
+        return;
+    }
+
+    displayMEntries(dict, arrMatched, nMatches, nManageChoice);
+
+    // if there are more than 1 match, ask the user which entry they wish
+    // to add lang-trans pairs to; otherwise, immediately start adding
+    // pairs to the sole match
+    if (nMatches > 1)
+    {
+        getEntryChoice(&nEntryChoice, arrMatched, nMatches);
+    }
+    else
+    {
+        nEntryChoice = arrMatched[0];
+    }
+
+    free(arrMatched);
+
+    getLangTrans(&tempLangVar, &tempTransVar);
+    assignNewEntries(dict, nEntryChoice, tempLangVar, tempTransVar);
+    free(tempLangVar);
+    free(tempTransVar);
+    displayDivider();
+    printf("Format (Language: Translation)\n");
+    displayCurrent(dict, nEntryChoice, nManageChoice);
+
+    // the user may or may not enter more language-translation pairs
+    addMoreTrans(dict, nEntryChoice, nManageChoice);
+}
+
+/**
+ * @brief
+ *    This function encompasses the Delete Entry Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nManageChoice   The integer of the user's choice in the Manage Data
+ * Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
+ *        Manage Data Menu).
+ */
+void
+deleteEntryFeat(Dictionary *dict, 
+                int nManageChoice)
+{
+    int nDelChoice;
+    int inputIsValid;
+
+    // just exit immediately to avoid a huge if block
+    if (countEntries(dict) == 0)
+    {
+        displayNoneMsg(nManageChoice);
+        return;
+    }
+
+    displayAllEntries(dict, nManageChoice);
+
+    // get the index of the entry that the user wants to delete
+    inputIsValid = getDelChoice(&nDelChoice, countEntries(dict));
+    if (inputIsValid)
+    {
+        deleteEntry(dict, getEntryIndex(dict, nDelChoice - 1) + 1);
+        displayDivider();
+        printf("Entry successfully deleted. ");
+        printf("Going back to the Manage Data Menu now...\n");
+    }
+    else
+    {
+        displayInvDel();
+    }
+}
+
+/**
+ * @brief
+ *    This function encompasses the Delete Translation Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nManageChoice   The integer of the user's choice in the
+ *                        Manage Data Menu.
+ *
+ * @pre    nManageChoice is >= 1 and <= 10 (the amount of choices in the
+ *         Manage Data Menu).
+ */
+void
+deleteTransFeat(Dictionary *dict, 
+                int nManageChoice)
+{
+    int nDelChoice, nDelIndex;
+    int inputIsValid;
+    int over = 0;
+
+    // exit immediately to avoid huge if block
+    if (countEntries(dict) == 0)
+    {
+        displayNoneMsg(nManageChoice);
+        return;
+    }
+
+    displayAllEntries(dict, nManageChoice);
+
+    // exit immediately if user input is invalid to avoid huge if block
+    inputIsValid = getDelChoice(&nDelChoice, countEntries(dict));
+    if (!inputIsValid)
+    {
+        displayInvDel();
+        return;
+    }
+
+    // from the number the user sees to where the entry is
+    nDelChoice = getEntryIndex(dict, nDelChoice - 1) + 1;
+
+    displayCurrent(dict, nDelChoice - 1, nManageChoice);
+
+    // loop until the user chooses to stop deleting or until the entry
+    // itself is deleted
+    while (!over)
+    {
+        inputIsValid = getDelIndex(dict, &nDelIndex, nDelChoice);
+
+        // don't force user to enter valid input
+        if (!inputIsValid)
+            return;
+
+        // if the last "dest/target" language-translation pair is deleted,
+        // delete the entry itself
+        if (dict->entries[nDelChoice - 1].count == 2)
+        {
+            deleteEntry(dict, nDelChoice);
+
+            printf("\n\nThe whole entry has been deleted. ");
+            printf("Going back to the Manage Data Menu now...\n");
+            over = 1;
+        }
+        else
+        {
+            // if the entry was not deleted, delete the pair and
+            // ask the user if they wish to delete more pairs
+            deleteTrans(dict, nDelChoice, nDelIndex);
+            displayCurrent(dict, nDelChoice - 1, nManageChoice);
+            displayDelAgain();
+            over = !getUserConfirmation();
+        }
+    }
+}
+
+/**
+ * @brief
+ *    This function encompasses the Display All Entries Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nManageChoice   The integer of the user's choice in the
+ *                        Manage Data Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
+ *        Manage Data Menu).
+ */
+void
+displayAllFeat(Dictionary *dict, 
+               int nManageChoice)
+{
+    if (countEntries(dict) > 0)
+        displayAllEntries(dict, nManageChoice);
+    else
+        displayNoneMsg(nManageChoice);
+}
+
+/**
+ * @brief
+ *    This function encompasses the Search Word Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict            The dictionary containing all the entries and
+ *                        language-translation pairs.
+ * @param nManageChoice   The integer of the user's choice in the
+ *                        Manage Data Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
+ *        Manage Data menu).
+ */
+void
+searchWordFeat(Dictionary *dict, 
+               int nManageChoice)
+{
+    int nMatches;
+    int *arrMatched; // array to store the indices of the matched entries
+    int wordIsInEntry;
+    char *strKey;
+
+    getKey(&strKey);
+
+    // sort entries before searching to avoid mismatch
+    arrangeEntries(dict);
+
+    // find word in all of the language-translation pairs of entries
+    arrMatched = (int *)malloc((dict->nEntries + 1) * sizeof(int));
+    wordIsInEntry = findWordInAllEntries(dict, strKey, arrMatched, &nMatches,
+                                         0, -1);
+
+    if (wordIsInEntry)
+    {
+        // if the word was found at least once, sort all entries,
+        // then display the matched entries
+        displayMEntries(dict, arrMatched, nMatches, nManageChoice);
+    }
+    else
+    {
+        // the word is not found in the list of entries
+        displayNoneMsg(nManageChoice);
+    }
+
+    free(strKey);
+    free(arrMatched);
+}
+
+/**
+ * @brief
+ *    This function encompasses the Search Translation Feature of the the
+ *    Manage Data Menu.
+ *
+ * @param dict             The dictionary containing all the entries and
+ *                         language-translation pairs.
+ * @param nManageChoice    The integer of the user's choice in the
+ *                         Manage Data Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (the amount of options in the
+ *        Manage Data Menu).
+ */
+void
+searchTransFeat(Dictionary *dict, 
+                int nManageChoice)
+{
+    int nMatches;
+    int *arrMatched; // array to store the indices of the matched entries
+    int pairIsInEntry;
+    char *tempLangVar, *tempTransVar;
+
+    getLangTrans(&tempLangVar, &tempTransVar);
+
+    // sort entries before searching to avoid mismatch
+    arrangeEntries(dict);
+
+    // find pair in all of the language-translation pairs of entries
+    arrMatched = (int *)malloc((dict->nEntries + 1) * sizeof(int));
+    pairIsInEntry = findPairInAllEntries(tempLangVar, tempTransVar, dict,
+                                         arrMatched, &nMatches, 0, -1);
+
+    if (pairIsInEntry)
+        displayMEntries(dict, arrMatched, nMatches, nManageChoice);
+    else
+        displayNoneMsg(nManageChoice);
+
+    free(tempLangVar);
+    free(tempTransVar);
+    free(arrMatched);
+}
+
+/**
+ * @brief
+ *    Displays the report of the export running in the background (see
+ *    startExport()) once it is done, and lets go of it. Nothing is done if
+ *    there is no export or if it is still running.
+ *
+ * @param dict   The dictionary being exported.
+ */
+void
+reportExport(Dictionary *dict)
+{
+    ExportJob *job = dict->exporting;
+    int isDone;
+
+    if (job == NULL)
+        return;
+
+    pthread_mutex_lock(&job->lock);
+    isDone = job->isDone;
+    pthread_mutex_unlock(&job->lock);
+
+    if (isDone)
+    {
+        waitForExport(dict);
+
+        displayDivider();
+        if (job->isWritten)
+        {
+            printf("Export of %s complete!\n", job->filename);
+            displayExportStats(stdout, &job->stats);
+        }
+        else
+        {
+            printf("Export of %s failed!\n", job->filename);
+        }
+
+        pthread_mutex_destroy(&job->lock);
+        free(job);
+        dict->exporting = NULL;
+    }
+}
+
+/**
+ * @brief
+ *    Starts writing the entries of a dictionary to a text file (see
+ *    exportText()) on a thread of its own, so the menus can be used while
+ *    it is written. The dictionary must not be changed until it is done
+ *    (see beginChange()). If the thread cannot be started, the file is
+ *    written right away.
+ *
+ * @param dict       The dictionary to be written.
+ * @param filename   The name of the text file.
+ */
+void
+startExport(Dictionary *dict,
+            char *filename)
+{
+    ExportJob *job;
+
+    // only one export runs at a time
+    waitForExport(dict);
+    reportExport(dict);
+
+    job = (ExportJob *)malloc(sizeof(ExportJob));
+    if (job == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    job->dict = dict;
+    strcpy(job->filename, filename);
+    job->isDone = 0;
+    job->isJoined = 0;
+    pthread_mutex_init(&job->lock, NULL);
+    dict->exporting = job;
+
+    if (pthread_create(&job->thread, NULL, exportWorker, job) != 0)
+    {
+        exportWorker(job);
+        job->isJoined = 1;
+    }
+}
+
+/**
+ * @brief
+ *    This function encompasses the Export Feature of the the
+ *    Manage Data Menu. The text file is written in the background (see
+ *    startExport()), while a filename ending in ".snap" writes a snapshot
+ *    (see exportSnapshot()) instead.
+ *
+ * @param dict             The dictionary containing all the entries and
+ *                         language-translation pairs.
+ * @param nManageChoice    The integer of the user's choice in the
+ *                         Manage Data Menu.
+ *
+ * @pre   nManageChoice is >= 1 and <= 10 (the amount of options in the
+ *        Manage Data Menu).
+ */
+void
+exportFeat(Dictionary *dict, 
+           int nManageChoice)
+{
+    String30 filename;
+
+    // immediately exit if there are no entries to export
+    if (countEntries(dict) == 0)
+    {
+        displayNoneMsg(nManageChoice);
+        return;
+    }
+
+    getFileName(filename);
+
+    // a snapshot holds the indexes as well, so it is written on its own
+    if (isSnapshotFile(filename))
+    {
+        displayDivider();
+        if (exportSnapshot(dict, filename))
+            printf("Snapshot export complete!\n");
+        else
+            printf("Something went wrong! Exiting...\n");
+
+        return;
+    }
+
+    // the report is displayed once the file is written (see
+    // reportExport())
+    startExport(dict, filename);
+
+    displayDivider();
+    printf("Exporting to %s in the background...\n", filename);
+}
+
+/**
+ * @brief
+ *    Removes the last entry of the dictionary, which was scanned from a file
+ *    and is not in the indexes.
+ *
+ * @param dict   The dictionary where the scanned entry was appended.
+ */
+void
+dropLastEntry(Dictionary *dict)
+{
+    Entry *last;
+
+    beginChange(dict);
+    recordChange(dict, JOURNAL_DROP_LAST, 0, 0, NULL, NULL);
+    last = &dict->entries[dict->nEntries - 1];
+
+    // if the entry is the last block of the pair pool, dropping it only
+    // needs the counts to be rewound
+    if (last->offset + last->capacity == dict->nPairs)
+        dict->nPairs = last->offset;
+
+    dict->nEntries--;
+}
+
+/**
+ * @brief
+ *    This function displays an entry scanned from a file and asks the user
+ *    if they wish to import it. If not, the entry is removed again.
+ *
+ * @param dict      The dictionary where the scanned entry was appended.
+ * @param nEntry    The index of the scanned entry (the last entry).
+ * @param nLoaded   The number of the scanned entry in the file.
+ *
+ * @pre   nEntry is dict->nEntries - 1.
+ *
+ * @return
+ *    1   if the entry was added.
+ *    0   if it was removed.
+ */
+int
+confirmLoadedEntry(Dictionary *dict,
+                   int nEntry,
+                   int nLoaded)
+{
+    int j;
+    int isAdded;
+    Pair *pairs = getPair(dict, nEntry, 0);
+
+    // display the scanned entry
+    displayDivider();
+    printf("Format (Language: Translation)\n\n");
+    printf("Loaded Entry No. %d\n", nLoaded);
+    for (j = 0; j < dict->entries[nEntry].count; j++)
+    {
+        printf("(%d) %s: %s\n", j + 1, getLangName(dict, pairs[j].lang),
+                                       getTrans(dict, &pairs[j]));
+    }
+
+    // ask the user if they wish to import the loaded entry
+    printf("\nDo you want to add the loaded ");
+    printf("entry to your data? ");
+
+    isAdded = getUserConfirmation();
+    if (isAdded)
+        indexEntry(dict, nEntry);
+    else
+        dropLastEntry(dict);
+
+    return isAdded;
+}
+
+/**
+ * @brief
+ *    Adds the pairs of an entry scanned from a file that are not in an
+ *    existing entry with the same "source" pair to that entry, and then
+ *    removes the scanned entry.
+ *
+ * @param dict     The dictionary where the scanned entry was appended.
+ * @param nEntry   The index of the scanned entry (the last entry).
+ * @param nMatch   The index of the existing entry.
+ */
+void
+mergeLoadedEntry(Dictionary *dict,
+                 int nEntry,
+                 int nMatch)
+{
+    char *tempLangVar, *tempTransVar;
+    Pair *pair;
+    int j;
+
+    for (j = 1; j < dict->entries[nEntry].count; j++)
+    {
+        // the pair pool and the string pool may move while pairs are added,
+        // so the pair is copied first
+        pair = getPair(dict, nEntry, j);
+        if (isPairInEntry(dict, nMatch, pair->lang, pair->trans, 0, -1) ==
+            -1)
+        {
+            tempLangVar = copyString(getLangName(dict, pair->lang),
+                                     getStringLen(&dict->langs, pair->lang));
+            tempTransVar = copyString(getTrans(dict, pair), pair->len);
+            assignNewEntries(dict, nMatch, tempLangVar, tempTransVar);
+            free(tempLangVar);
+            free(tempTransVar);
+        }
+    }
+
+    dropLastEntry(dict);
+}
+
+/**
+ * @brief
+ *    Replaces the pairs of an existing entry with the pairs of an entry
+ *    scanned from a file that has the same "source" pair, and then removes
+ *    the scanned entry. The existing entry keeps its place.
+ *
+ * @param dict     The dictionary where the scanned entry was appended.
+ * @param nEntry   The index of the scanned entry (the last entry).
+ * @param nMatch   The index of the existing entry.
+ */
+void
+replaceWithLoadedEntry(Dictionary *dict,
+                       int nEntry,
+                       int nMatch)
+{
+    // the existing entry takes over the pairs of the scanned entry, while
+    // the slots of its old pairs are left unused; it stays in the same
+    // chain of the word index since its "source" pair is the same
+    beginChange(dict);
+    recordChange(dict, JOURNAL_REPLACE, nEntry, nMatch, NULL, NULL);
+    unindexWords(dict, nMatch);
+    dict->entries[nMatch] = dict->entries[nEntry];
+    dict->srcKeys[nMatch] = dict->srcKeys[nEntry];
+    dict->nEntries--;
+    dict->isArranged = 0;
+    indexPhrases(dict, nMatch);
+    indexWords(dict, nMatch);
+}
+
+/**
+ * @brief
+ *    Imports an entry scanned from a file according to an import policy.
+ *    Entries are duplicates when their "source" pairs are the same, which is
+ *    checked with the word index instead of a scan over all entries.
+ *
+ * @param dict      The dictionary where the scanned entry was appended.
+ * @param nEntry    The index of the scanned entry (the last entry).
+ * @param nPolicy   How the entry is imported (IMPORT_ASK and so on).
+ * @param nLoaded   The number of the scanned entry in the file.
+ * @param stats     The amounts of entries imported in each way, which are
+ *                  updated.
+ */
+void
+finishLoadedEntry(Dictionary *dict,
+                  int nEntry,
+                  int nPolicy,
+                  int nLoaded,
+                  ImportStats *stats)
+{
+    SourceKey *key = &dict->srcKeys[nEntry];
+    int nMatch = -1;
+
+    if (nPolicy == IMPORT_SKIP || nPolicy == IMPORT_MERGE ||
+        nPolicy == IMPORT_REPLACE)
+        nMatch = findSourcePair(dict, key->lang, key->trans);
+
+    if (nPolicy == IMPORT_ASK)
+    {
+        if (confirmLoadedEntry(dict, nEntry, nLoaded))
+            stats->nAdded++;
+        else
+            stats->nSkipped++;
+    }
+    else if (nMatch == -1)
+    {
+        indexEntry(dict, nEntry);
+        stats->nAdded++;
+    }
+    else if (nPolicy == IMPORT_SKIP)
+    {
+        dropLastEntry(dict);
+        stats->nSkipped++;
+    }
+    else if (nPolicy == IMPORT_MERGE)
+    {
+        mergeLoadedEntry(dict, nEntry, nMatch);
+        stats->nMerged++;
+    }
+    else
+    {
+        replaceWithLoadedEntry(dict, nEntry, nMatch);
+        stats->nReplaced++;
+    }
+}
+
+/**
+ * @brief
+ *    Parses a line of a dictionary file as a language-translation pair in
+ *    the format "Language: Translation". The language is converted to title
+ *    case and the translation to lowercase, the same way user input is.
+ *    The function sscanf () was used in this function to parse strings.
+ *    This topic was self-studied as it is outside the topics discussed in
+ *    CCPROG2. Lesson Reference: https://www.youtube.com/watch?v=-7cSmcdMryo
+ *
+ * @details
+ *    The line is only measured (%n stores how many characters were read so
+ *    far), and the language and translation are then ended in place, so
+ *    they can be of any length.
+ *
+ * @param line            The line to be parsed, of any length, which is
+ *                        changed. Both "\n" and "\r\n" line endings are
+ *                        accepted.
+ * @param pTempLangVar    The address where the language is stored (a part
+ *                        of the line).
+ * @param pTempTransVar   The address where the translation is stored (a
+ *                        part of the line).
+ *
+ * @return
+ *    LINE_PAIR    if the line is a language-translation pair.
+ *    LINE_OTHER   if not (e.g. the blank line at the end of an entry).
+ */
+int
+parsePairLine(char *line,
+              char **pTempLangVar,
+              char **pTempTransVar)
+{
+    int nLangEnd = 0, nTransStart = 0, nTransEnd = 0;
+    int nReturn = LINE_OTHER;
+
+    sscanf(line, "%*[^:\r\n]%n: %n%*[^:\r\n]%n", &nLangEnd, &nTransStart,
+           &nTransEnd);
+
+    if (nTransEnd > 0)
+    {
+        line[nLangEnd] = '\0';
+        line[nTransEnd] = '\0';
+        *pTempLangVar = line;
+        *pTempTransVar = &line[nTransStart];
+        titleCase(*pTempLangVar);
+        lowercase(*pTempTransVar);
+        nReturn = LINE_PAIR;
+    }
+
+    return nReturn;
+}
+
+/**
+ * @brief
+ *    Adds a language-translation pair read from a file to the entry being
+ *    scanned, starting a new entry at the end of the dictionary if there is
+ *    none yet.
+ *
+ * @param dict           The dictionary where the entries are added.
+ * @param pEntry         The address of the index of the entry being scanned
+ *                       (-1 if none yet), which is updated.
+ * @param tempLangVar    The (title case) language of the pair.
+ * @param tempTransVar   The (lowercase) translation of the pair.
+ */
+void
+addLoadedPair(Dictionary *dict,
+              int *pEntry,
+              char *tempLangVar,
+              char *tempTransVar)
+{
+    if (*pEntry == -1)
+        *pEntry = newEntry(dict);
+
+    assignNewEntries(dict, *pEntry, tempLangVar, tempTransVar);
+}
+
+/**
+ * @brief
+ *    Imports the entry being scanned from a file (see finishLoadedEntry())
+ *    now that it has ended. Nothing is done if there is none.
+ *
+ * @param dict      The dictionary where the entries are added.
+ * @param pEntry    The address of the index of the entry being scanned (-1
+ *                  if none), which is reset to -1.
+ * @param pLoaded   The address of the number of the entry in the file,
+ *                  which is incremented.
+ * @param nPolicy   How the entry is imported (IMPORT_ASK and so on).
+ * @param stats     The amounts of entries imported in each way, which are
+ *                  updated.
+ */
+void
+endLoadedEntry(Dictionary *dict,
+               int *pEntry,
+               int *pLoaded,
+               int nPolicy,
+               ImportStats *stats)
+{
+    if (*pEntry != -1)
+    {
+        finishLoadedEntry(dict, *pEntry, nPolicy, *pLoaded, stats);
+        (*pLoaded)++;
+        *pEntry = -1;
+    }
+}
+
+/**
+ * @brief
+ *    Loads all the entries of a dictionary file and adds them to the end of
+ *    the dictionary. Entries are separated by lines that are not
+ *    language-translation pairs (see parsePairLine()).
+ *
+ * @param dict        The dictionary where the entries are added.
+ * @param fp_import   The dictionary file, opened for reading.
+ * @param nPolicy     How each entry is imported (see finishLoadedEntry()):
+ *                    IMPORT_ASK asks the user to confirm each entry,
+ *                    IMPORT_ACCEPT_ALL adds every entry, and IMPORT_SKIP,
+ *                    IMPORT_MERGE and IMPORT_REPLACE add the entries that
+ *                    are not duplicates and skip, merge or replace the rest.
+ * @param stats       The amounts of entries imported in each way, which are
+ *                    set.
+ */
+void
+loadEntries(Dictionary *dict,
+            FILE *fp_import,
+            int nPolicy,
+            ImportStats *stats)
+{
+    char *lineInput = NULL;
+    size_t nLineCap = 0;
+    int i, nKind;
+    int nEntry = -1; // index of the entry being scanned (-1 if none yet)
+    char *tempLangVar, *tempTransVar;
+
+    i = 1; // amount of entries scanned (not necessarily imported)
+    memset(stats, 0, sizeof(ImportStats));
+
+    // continue reading the file as long as EOF isn't encountered; getline()
+    // reads whole lines of any length into a buffer that grows as needed
+    while (getline(&lineInput, &nLineCap, fp_import) != -1)
+    {
+        nKind = parsePairLine(lineInput, &tempLangVar, &tempTransVar);
+
+        // if both the language and translation strings have
+        // been successfully parsed, add them to the entry being scanned,
+        // which is placed directly at the end of the dictionary
+        if (nKind == LINE_PAIR)
+            addLoadedPair(dict, &nEntry, tempLangVar, tempTransVar);
+        else // the entry has ended
+            endLoadedEntry(dict, &nEntry, &i, nPolicy, stats);
+    }
+
+    free(lineInput);
+
+    // the last entry does not need to be followed by a blank line
+    endLoadedEntry(dict, &nEntry, &i, nPolicy, stats);
+}
+
+/**
+ * @brief
+ *    Parses the lines of a part of a dictionary file into a list of pairs,
+ *    the same way loadEntries() parses each whole line, so the pairs are
+ *    the same. The lines that end an entry are kept in the list as well.
+ *
+ * @param chunk   The part of the file, whose lines and strings are set.
+ */
+void
+parseImportChunk(ImportChunk *chunk)
+{
+    char *lineInput = NULL;
+    int nLineCap = 0;
+    ParsedLine *line;
+    char *newline, *tempLangVar, *tempTransVar;
+    size_t i = 0, nLen;
+    int nKind, nLangLen, nTransLen;
+
+    chunk->lines = NULL;
+    chunk->nLines = 0;
+    chunk->nLineCap = 0;
+    chunk->strings = NULL;
+    chunk->nUsed = 0;
+    chunk->nStringCap = 0;
+
+    while (i < chunk->len)
+    {
+        nLen = chunk->len - i;
+        newline = (char *)memchr(&chunk->text[i], '\n', nLen);
+        if (newline != NULL)
+            nLen = newline - &chunk->text[i] + 1;
+
+        lineInput = (char *)growArray(lineInput, &nLineCap, nLen + 1, 1);
+        memcpy(lineInput, &chunk->text[i], nLen);
+        lineInput[nLen] = '\0';
+        i += nLen;
+
+        chunk->lines = (ParsedLine *)growArray(chunk->lines,
+                                               &chunk->nLineCap,
+                                               chunk->nLines + 1,
+                                               sizeof(ParsedLine));
+        line = &chunk->lines[chunk->nLines];
+        nKind = parsePairLine(lineInput, &tempLangVar, &tempTransVar);
+        line->nKind = nKind;
+
+        // the language and translation are kept with the other strings of
+        // the part, since the line is reused
+        if (nKind == LINE_PAIR)
+        {
+            nLangLen = strlen(tempLangVar) + 1;
+            nTransLen = strlen(tempTransVar) + 1;
+            chunk->strings = (char *)growArray(chunk->strings,
+                                               &chunk->nStringCap,
+                                               chunk->nUsed + nLangLen +
+                                               nTransLen, 1);
+            line->lang = chunk->nUsed;
+            memcpy(&chunk->strings[chunk->nUsed], tempLangVar, nLangLen);
+            chunk->nUsed += nLangLen;
+            line->trans = chunk->nUsed;
+            memcpy(&chunk->strings[chunk->nUsed], tempTransVar, nTransLen);
+            chunk->nUsed += nTransLen;
+        }
+
+        // a line that is not a pair only matters once after a pair
+        if (nKind != LINE_OTHER ||
+            (chunk->nLines > 0 &&
+             chunk->lines[chunk->nLines - 1].nKind != LINE_OTHER))
+            chunk->nLines++;
+    }
+
+    free(lineInput);
+}
+
+/**
+ * @brief
+ *    Parses the parts of an import job one at a time until there are no
+ *    more parts left. Each worker thread of the job runs this function.
+ *
+ * @param arg   The import job (an ImportJob).
+ *
+ * @return Returns NULL.
+ */
+void *
+importWorker(void *arg)
+{
+    ImportJob *job = (ImportJob *)arg;
+    int nChunk;
+    int over = 0;
+
+    while (!over)
+    {
+        // wait while the parsed parts that are not added yet are too many
+        pthread_mutex_lock(&job->lock);
+        while (job->nNext < job->nChunks &&
+               job->nNext >= job->nAdded + job->nWindow)
+        {
+            pthread_cond_wait(&job->done, &job->lock);
+        }
+        nChunk = job->nNext++;
+        pthread_mutex_unlock(&job->lock);
+
+        if (nChunk >= job->nChunks)
+        {
+            over = 1;
+        }
+        else
+        {
+            parseImportChunk(&job->chunks[nChunk]);
+
+            pthread_mutex_lock(&job->lock);
+            job->chunks[nChunk].isDone = 1;
+            pthread_cond_broadcast(&job->done);
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief
+ *    Splits the contents of a dictionary file into parts of about
+ *    IMPORT_CHUNK_SIZE characters that end after a blank line. An entry
+ *    never continues past a blank line, so the parts can be parsed
+ *    independently.
+ *
+ * @param text      The contents of the file.
+ * @param len       The amount of characters in the file.
+ * @param pChunks   The address where the number of parts is stored.
+ *
+ * @return Returns the parts, which must be freed by the caller.
+ */
+ImportChunk *
+splitImportChunks(char *text,
+                  size_t len,
+                  int *pChunks)
+{
+    ImportChunk *chunks = NULL;
+    int nChunkCap = 0;
+    size_t nStart = 0, nEnd;
+    char *newline;
+    int isFound;
+
+    *pChunks = 0;
+    while (nStart < len)
+    {
+        // end the part after the first blank line past its target size
+        nEnd = nStart + IMPORT_CHUNK_SIZE;
+        isFound = nEnd >= len;
+        while (!isFound)
+        {
+            newline = (char *)memchr(&text[nEnd], '\n', len - nEnd);
+            nEnd = newline == NULL ? len : (size_t)(newline - text) + 1;
+
+            if (nEnd >= len)
+            {
+                isFound = 1;
+            }
+            else if (text[nEnd] == '\n')
+            {
+                nEnd++;
+                isFound = 1;
+            }
+            else if (nEnd + 1 < len && text[nEnd] == '\r' &&
+                     text[nEnd + 1] == '\n')
+            {
+                nEnd += 2;
+                isFound = 1;
+            }
+        }
+
+        if (nEnd > len)
+            nEnd = len;
+
+        chunks = (ImportChunk *)growArray(chunks, &nChunkCap, *pChunks + 1,
+                                          sizeof(ImportChunk));
+        chunks[*pChunks].text = &text[nStart];
+        chunks[*pChunks].len = nEnd - nStart;
+        chunks[*pChunks].isDone = 0;
+        (*pChunks)++;
+
+        nStart = nEnd;
+    }
+
+    return chunks;
+}
+
+/**
+ * @brief
+ *    Returns the amount of worker threads used to parse dictionary files,
+ *    which is the amount of processors that are online.
+ *
+ * @return Returns a number from 1 to MAX_THREADS.
+ */
+int
+getImportThreads()
+{
+    long nCores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (nCores < 1)
+        nCores = 1;
+    else if (nCores > MAX_THREADS)
+        nCores = MAX_THREADS;
+
+    return (int)nCores;
+}
+
+/**
+ * @brief
+ *    Loads all the entries of a dictionary file like loadEntries() does
+ *    without asking the user, with the same result, but parses the file on
+ *    all processors. The file is mapped into memory and split into parts
+ *    (see splitImportChunks()) that are parsed by a pool of worker threads,
+ *    while the pairs of each part are added to the dictionary in their
+ *    original order as soon as the part and the parts before it are done.
+ *
+ * @param dict       The dictionary where the entries are added.
+ * @param filename   The name of the dictionary file.
+ * @param nPolicy    How each entry is imported (see loadEntries()).
+ * @param stats      The amounts of entries imported in each way, which are
+ *                   set.
+ *
+ * @pre   nPolicy is not IMPORT_ASK.
+ *
+ * @return
+ *    1   if the file was loaded.
+ *    0   if it could not be opened.
+ */
+int
+loadEntriesParallel(Dictionary *dict,
+                    char *filename,
+                    int nPolicy,
+                    ImportStats *stats)
+{
+    struct stat info;
+    ImportJob job;
+    ImportChunk *chunk;
+    ParsedLine *line;
+    pthread_t threads[MAX_THREADS];
+    FILE *fp_import = NULL;
+    char *text = MAP_FAILED;
+    size_t len = 0;
+    int fd, i, j, nStarted = 0;
+    int nThreads = getImportThreads();
+    int nEntry = -1; // index of the entry being scanned (-1 if none yet)
+    int nLoaded = 1; // amount of entries scanned (not necessarily imported)
+
+    memset(stats, 0, sizeof(ImportStats));
+
+    fd = open(filename, O_RDONLY);
+    if (fd == -1)
+        return 0;
+
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        len = info.st_size;
+        text = (char *)mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    close(fd);
+
+    // an empty file has no entries, while one that cannot be mapped is
+    // read the usual way
+    if (text == MAP_FAILED)
+    {
+        if (len > 0)
+            fp_import = fopen(filename, "r");
+
+        if (fp_import != NULL)
+        {
+            loadEntries(dict, fp_import, nPolicy, stats);
+            fclose(fp_import);
+        }
+
+        return len == 0 || fp_import != NULL;
+    }
+
+    job.chunks = splitImportChunks(text, len, &job.nChunks);
+    job.nNext = 0;
+    job.nAdded = 0;
+    job.nWindow = 4 * nThreads;
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.done, NULL);
+
+    for (i = 0; i < nThreads; i++)
+    {
+        if (pthread_create(&threads[nStarted], NULL, importWorker, &job) ==
+            0)
+            nStarted++;
+    }
+
+    // add each part as soon as it and the parts before it are parsed
+    for (i = 0; i < job.nChunks; i++)
+    {
+        chunk = &job.chunks[i];
+
+        // parse the part in this thread if no thread could start
+        if (nStarted == 0)
+        {
+            parseImportChunk(chunk);
+            chunk->isDone = 1;
+        }
+
+        pthread_mutex_lock(&job.lock);
+        while (!chunk->isDone)
+        {
+            pthread_cond_wait(&job.done, &job.lock);
+        }
+        pthread_mutex_unlock(&job.lock);
+
+        for (j = 0; j < chunk->nLines; j++)
+        {
+            line = &chunk->lines[j];
+            if (line->nKind == LINE_PAIR)
+                addLoadedPair(dict, &nEntry, &chunk->strings[line->lang],
+                              &chunk->strings[line->trans]);
+            else
+                endLoadedEntry(dict, &nEntry, &nLoaded, nPolicy, stats);
+        }
+
+        free(chunk->lines);
+        free(chunk->strings);
+
+        pthread_mutex_lock(&job.lock);
+        job.nAdded++;
+        pthread_cond_broadcast(&job.done);
+        pthread_mutex_unlock(&job.lock);
+    }
+
+    // the last entry does not need to be followed by a blank line
+    endLoadedEntry(dict, &nEntry, &nLoaded, nPolicy, stats);
+
+    for (i = 0; i < nStarted; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&job.done);
+    pthread_mutex_destroy(&job.lock);
+    free(job.chunks);
+    munmap(text, len);
+
+    return 1;
+}
+
+/**
+ * @brief
+ *    Returns the name of the journal of a snapshot, which is the name of the
+ *    snapshot with JOURNAL_EXT in place of SNAP_EXT.
+ *
+ * @param snapName   The name of the snapshot (ending in SNAP_EXT).
+ *
+ * @return Returns the name, which must be freed by the caller.
+ */
+char *
+getJournalName(char *snapName)
+{
+    size_t nBaseLen = strlen(snapName) - strlen(SNAP_EXT);
+    char *journalName = (char *)malloc(nBaseLen + strlen(JOURNAL_EXT) + 1);
+
+    if (journalName == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(journalName, snapName, nBaseLen);
+    strcpy(&journalName[nBaseLen], JOURNAL_EXT);
+
+    return journalName;
+}
+
+/**
+ * @brief
+ *    Starts a new, empty journal for the current generation of the
+ *    dictionary, replacing the journal file.
+ *
+ * @param journal       The journal.
+ * @param nGeneration   The generation of the snapshot the journal follows.
+ *
+ * @return
+ *    1   if the journal file was written.
+ *    0   if not.
+ */
+int
+resetJournal(Journal *journal,
+             unsigned int nGeneration)
+{
+    JournalHeader header;
+    int isWritten;
+
+    if (journal->fd != -1)
+        close(journal->fd);
+
+    journal->fd = open(journal->journalName,
+                       O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    journal->nPending = 0;
+    journal->nRecords = 0;
+    if (journal->fd == -1)
+        return 0;
+
+    memset(&header, 0, sizeof(JournalHeader));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    header.version = JOURNAL_VERSION;
+    header.nGeneration = nGeneration;
+
+    isWritten = writeAll(journal->fd, (char *)&header, sizeof(JournalHeader));
+
+    return isWritten && fdatasync(journal->fd) == 0;
+}
+
+/**
+ * @brief
+ *    Folds the journal of a dictionary back into its snapshot: the whole
+ *    dictionary is written as the next generation of the snapshot, and the
+ *    journal is started over. A journal left over from an earlier
+ *    generation (e.g. after a crash in between) is ignored by openJournal().
+ *
+ * @param dict   The dictionary with a journal.
+ *
+ * @return
+ *    1   if the snapshot and the journal were written.
+ *    0   if not, in which case the changes stay in the journal.
+ */
+int
+compactJournal(Dictionary *dict)
+{
+    Journal *journal = dict->journal;
+    int isWritten;
+
+    // the changes stay safe in the journal until the snapshot is written
+    isWritten = flushJournal(journal) && fdatasync(journal->fd) == 0;
+
+    dict->nGeneration++;
+    if (isWritten && exportSnapshot(dict, journal->snapName))
+    {
+        isWritten = resetJournal(journal, dict->nGeneration);
+    }
+    else
+    {
+        dict->nGeneration--;
+        isWritten = 0;
+    }
+
+    return isWritten;
+}
+
+/**
+ * @brief
+ *    Makes sure that every change recorded so far has reached the disk,
+ *    with a single fdatasync() call for the whole batch. The journal is
+ *    compacted (see compactJournal()) once it holds JOURNAL_COMPACT_RECORDS
+ *    changes. Nothing is done if the dictionary has no journal.
+ *
+ * @param dict   The dictionary.
+ */
+void
+syncJournal(Dictionary *dict)
+{
+    Journal *journal = dict->journal;
+
+    if (journal == NULL)
+        return;
+
+    if (!flushJournal(journal) || fdatasync(journal->fd) != 0)
+    {
+        printf("Cannot write the journal! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (journal->nRecords >= JOURNAL_COMPACT_RECORDS)
+        compactJournal(dict);
+}
+
+/**
+ * @brief
+ *    Makes a change read from a journal again (see recordChange()), after
+ *    checking that its arguments make sense for the dictionary.
+ *
+ * @param dict     The dictionary, which has no journal while it is replayed.
+ * @param record   The change.
+ * @param lang     The language of the change ("" if none).
+ * @param trans    The translation of the change ("" if none).
+ *
+ * @return
+ *    1   if the change was made.
+ *    0   if the change is not valid.
+ */
+int
+replayChange(Dictionary *dict,
+             JournalRecord *record,
+             char *lang,
+             char *trans)
+{
+    int nArg1 = record->arg1, nArg2 = record->arg2;
+    int isValid = 1;
+
+    switch (record->op)
+    {
+        case JOURNAL_NEW_ENTRY:
+            newEntry(dict);
+            break;
+        case JOURNAL_ADD_PAIR:
+            isValid = nArg1 >= 0 && nArg1 < dict->nEntries;
+            if (isValid)
+                assignNewEntries(dict, nArg1, lang, trans);
+            break;
+        case JOURNAL_INDEX_ENTRY:
+            isValid = nArg1 >= dict->index.nIndexed &&
+                      nArg1 < dict->nEntries &&
+                      dict->entries[nArg1].count > 0;
+            if (isValid)
+                indexEntry(dict, nArg1);
+            break;
+        case JOURNAL_DELETE_ENTRY:
+            isValid = nArg1 >= 1 && isEntryIndexed(dict, nArg1 - 1) &&
+                      !isEntryDeleted(dict, nArg1 - 1);
+            if (isValid)
+                deleteEntry(dict, nArg1);
+            break;
+        case JOURNAL_DELETE_PAIR:
+            isValid = nArg1 >= 1 && nArg1 <= dict->nEntries &&
+                      nArg2 >= 1 && nArg2 <= dict->entries[nArg1 - 1].count;
+            if (isValid)
+                deleteTrans(dict, nArg1, nArg2);
+            break;
+        case JOURNAL_ARRANGE:
+            arrangeEntries(dict);
+            break;
+        case JOURNAL_DROP_LAST:
+            isValid = dict->nEntries > dict->index.nIndexed;
+            if (isValid)
+                dropLastEntry(dict);
+            break;
+        case JOURNAL_REPLACE:
+            isValid = nArg1 == dict->nEntries - 1 && nArg2 >= 0 &&
+                      nArg2 < dict->index.nIndexed;
+            if (isValid)
+                replaceWithLoadedEntry(dict, nArg1, nArg2);
+            break;
+        case JOURNAL_EMPTY:
+            emptyEntry(dict);
+            break;
+        case JOURNAL_FIRST_LANG:
+            setFirstLang(dict, lang);
+            break;
+        case JOURNAL_COMPACT:
+            isValid = dict->index.nIndexed == dict->nEntries;
+            if (isValid)
+                compactEntries(dict);
+            break;
+        default:
+            isValid = 0;
+    }
+
+    return isValid;
+}
+
+/**
+ * @brief
+ *    Makes the changes of a journal file again, in order, up to the first
+ *    change that is incomplete (e.g. cut short by a crash) or damaged.
+ *
+ * @param dict       The dictionary, which has no journal while it is
+ *                   replayed.
+ * @param fd         The journal file, positioned after its header.
+ * @param pRecords   The address where the amount of changes that were
+ *                   made is stored.
+ *
+ * @return Returns the size of the part of the file that was replayed.
+ */
+off_t
+replayJournal(Dictionary *dict,
+              int fd,
+              long *pRecords)
+{
+    JournalRecord record;
+    struct stat info;
+    char *data = NULL, *lang, *trans;
+    size_t nSize = 0, nRead = 0, i = 0;
+    ssize_t nChunk = 1;
+    unsigned int check;
+    int isValid = 1;
+
+    // the records are of different sizes, so the rest of the file is read
+    // first (it is compacted before it grows large, see syncJournal())
+    if (fstat(fd, &info) == 0 && info.st_size > (off_t)sizeof(JournalHeader))
+        nSize = info.st_size - sizeof(JournalHeader);
+
+    data = (char *)malloc(nSize + 1);
+    if (data == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while (nRead < nSize && nChunk > 0)
+    {
+        nChunk = read(fd, &data[nRead], nSize - nRead);
+        if (nChunk > 0)
+            nRead += nChunk;
+    }
+
+    *pRecords = 0;
+    while (isValid && nRead - i >= sizeof(JournalRecord))
+    {
+        memcpy(&record, &data[i], sizeof(JournalRecord));
+        isValid = record.nLangLen >= 0 && record.nTransLen >= 0 &&
+                  (size_t)record.nLangLen + record.nTransLen <=
+                  nRead - i - sizeof(JournalRecord);
+
+        if (isValid)
+        {
+            lang = &data[i + sizeof(JournalRecord)];
+            trans = &lang[record.nLangLen];
+            check = record.check;
+            record.check = 0;
+            isValid = hashBytes(trans, record.nTransLen,
+                                hashBytes(lang, record.nLangLen,
+                                          hashBytes((char *)&record,
+                                                    sizeof(JournalRecord),
+                                                    2166136261u))) == check;
+        }
+
+        if (isValid)
+        {
+            lang = copyString(lang, record.nLangLen);
+            trans = copyString(trans, record.nTransLen);
+            isValid = replayChange(dict, &record, lang, trans);
+            free(lang);
+            free(trans);
+        }
+
+        if (isValid)
+        {
+            i += sizeof(JournalRecord) + record.nLangLen + record.nTransLen;
+            (*pRecords)++;
+        }
+    }
+
+    free(data);
+
+    return sizeof(JournalHeader) + i;
+}
+
+/**
+ * @brief
+ *    Loads a persistent dictionary: its snapshot (if there is one yet), and
+ *    then the changes in its journal since the snapshot was written. From
+ *    then on, every change to the dictionary is recorded in the journal
+ *    (see recordChange()).
+ *
+ * @param dict       The (empty) dictionary to be loaded.
+ * @param snapName   The name of the snapshot (ending in SNAP_EXT).
+ *
+ * @return
+ *    1   if the dictionary was loaded.
+ *    0   if the snapshot is not valid or the journal cannot be written.
+ */
+int
+openJournal(Dictionary *dict,
+            char *snapName)
+{
+    Journal *journal;
+    JournalHeader header;
+    off_t nValid = 0;
+    long nRecords = 0;
+    int fd;
+
+    if (access(snapName, F_OK) == 0 && !loadSnapshot(dict, snapName))
+    {
+        fprintf(stderr, "Cannot load snapshot: %s\n", snapName);
+        return 0;
+    }
+
+    journal = (Journal *)malloc(sizeof(Journal));
+    if (journal == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    journal->snapName = snapName;
+    journal->journalName = getJournalName(snapName);
+    journal->fd = -1;
+    journal->pending = NULL;
+    journal->nPending = 0;
+    journal->nPendingCap = 0;
+    journal->nRecords = 0;
+    journal->nPaused = 0;
+
+    // only a journal that follows this generation of the snapshot is used
+    fd = open(journal->journalName, O_RDWR);
+    if (fd != -1 &&
+        read(fd, &header, sizeof(JournalHeader)) ==
+        (ssize_t)sizeof(JournalHeader) &&
+        !memcmp(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) &&
+        header.version == JOURNAL_VERSION &&
+        header.nGeneration == dict->nGeneration)
+    {
+        nValid = replayJournal(dict, fd, &nRecords);
+    }
+
+    if (fd != -1)
+        close(fd);
+
+    // drop anything after the last complete change before appending
+    if (nValid > 0)
+    {
+        journal->fd = open(journal->journalName, O_WRONLY | O_APPEND);
+        if (journal->fd != -1 && ftruncate(journal->fd, nValid) != 0)
+        {
+            close(journal->fd);
+            journal->fd = -1;
+        }
+
+        journal->nRecords = nRecords;
+    }
+
+    if (journal->fd == -1 && !resetJournal(journal, dict->nGeneration))
+    {
+        fprintf(stderr, "Cannot write journal: %s\n", journal->journalName);
+        free(journal->journalName);
+        free(journal);
+        return 0;
+    }
+
+    dict->journal = journal;
+
+    // an entry that was still being added when the journal ended is
+    // dropped, and that is recorded as well
+    while (dict->nEntries > dict->index.nIndexed)
+    {
+        dropLastEntry(dict);
+    }
+
+    return 1;
+}
+
+/**
+ * @brief
+ *    Folds the journal of a persistent dictionary into its snapshot (see
+ *    compactJournal()) and closes it. Nothing is done if the dictionary has
+ *    no journal.
+ *
+ * @param dict   The dictionary.
+ *
+ * @return
+ *    1   if every change is saved.
+ *    0   if not.
+ */
+int
+closeJournal(Dictionary *dict)
+{
+    Journal *journal = dict->journal;
+    int isSaved;
+
+    if (journal == NULL)
+        return 1;
+
+    waitForExport(dict);
+
+    // if the snapshot cannot be written, the changes stay in the journal
+    isSaved = compactJournal(dict);
+    if (!isSaved)
+        isSaved = flushJournal(journal) && fdatasync(journal->fd) == 0;
+
+    close(journal->fd);
+    free(journal->pending);
+    free(journal->journalName);
+    free(journal);
+    dict->journal = NULL;
+
+    return isSaved;
+}
+
+/**
+ * @brief
+ *    This function asks the user how the entries of a file are imported
+ *    (see loadEntries()).
+ *
+ * @return Returns the import policy (IMPORT_ASK and so on).
+ */
+int
+getImportPolicy()
+{
+    displayDivider();
+
+    char menuText[] = "How should the entries be imported?\n"
+                      "1 - Ask for each entry\n"
+                      "2 - Add all entries\n"
+                      "3 - Skip entries whose \"source\" pair already exists\n"
+                      "4 - Merge them into the existing entries\n"
+                      "5 - Replace the existing entries with them";
+
+    printf("%s", menuText);
+    printf("\n\nEnter a number from 1 to 5.\n");
+
+    return getIntInput(IMPORT_ASK, IMPORT_REPLACE);
+}
+
+/**
+ * @brief
+ *    This function encompasses the Import Feature of the the Manage Data Menu.
+ *    Text files are imported entry by entry, while a snapshot (see
+ *    loadSnapshot()) replaces the whole dictionary.
+ *
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs.
+ */
+void
+importFeat(Dictionary *dict)
+{
+    FILE *fp_import = NULL;
+    String30 filename;
+    ImportStats stats;
+    unsigned int nGeneration;
+    int nPolicy;
+
+    getFileName(filename);
+    displayDivider();
+
+    // a snapshot is used as it is, so it replaces the current entries
+    if (isSnapshotFile(filename))
+    {
+        if (countEntries(dict) > 0)
+        {
+            printf("Importing a snapshot replaces all the current ");
+            printf("entries. Do you want to continue? ");
+            if (!getUserConfirmation())
+                return;
+
+            displayDivider();
+        }
+
+        // a persistent dictionary carries on with its own generation, and
+        // the snapshot it follows is replaced at once
+        nGeneration = dict->nGeneration;
+        if (loadSnapshot(dict, filename))
+        {
+            if (dict->journal != NULL)
+            {
+                dict->nGeneration = nGeneration;
+                compactJournal(dict);
+            }
+
+            printf("Snapshot import complete!\n");
+        }
+        else
+            printf("File does not exist or is not a valid snapshot.\n");
+
+        return;
+    }
+
+    // exit immediately if file does not exist or cannot be accessed
+    fp_import = fopen(filename, "r");
+    if (fp_import == NULL)
+    {
+        printf("File does not exist or cannot be accessed.\n");
+        return;
+    }
+    else
+    {
+        printf("File successfully loaded.\n");
+    }
+
+    // only the entries that are confirmed one by one are read serially
+    nPolicy = getImportPolicy();
+    if (nPolicy == IMPORT_ASK)
+    {
+        loadEntries(dict, fp_import, nPolicy, &stats);
+        fclose(fp_import);
+    }
+    else
+    {
+        fclose(fp_import);
+        loadEntriesParallel(dict, filename, nPolicy, &stats);
+    }
+
+    displayDivider();
+    printf("File import complete!\n");
+    printf("Added: %d, Skipped: %d, Merged: %d, Replaced: %d\n",
+           stats.nAdded, stats.nSkipped, stats.nMerged, stats.nReplaced);
+}
+
+/**
+ * @brief Initializes an empty text buffer.
+ *
+ * @param buf   The text buffer to be initialized.
+ */
+void
+initTextBuf(TextBuf *buf)
+{
+    buf->data = NULL;
+    buf->len = 0;
+    buf->cap = 0;
+}
+
+/**
+ * @brief Frees the memory used by a text buffer.
+ *
+ * @param buf   The text buffer to be freed.
+ */
+void
+freeTextBuf(TextBuf *buf)
+{
+    free(buf->data);
+}
+
+/**
+ * @brief
+ *    Makes sure that a text buffer can hold nMore more characters, doubling
+ *    its capacity until it can.
+ *
+ * @param buf     The text buffer to be grown.
+ * @param nMore   The amount of characters to be added to the buffer.
+ */
+void
+reserveText(TextBuf *buf,
+            size_t nMore)
+{
+    size_t newCap = buf->cap;
+
+    if (buf->len + nMore > buf->cap)
+    {
+        if (newCap < TEXT_MIN_CAPACITY)
+            newCap = TEXT_MIN_CAPACITY;
+
+        while (newCap < buf->len + nMore)
+        {
+            newCap *= 2;
+        }
+
+        buf->data = (char *)realloc(buf->data, newCap);
+        if (buf->data == NULL)
+        {
+            printf("Out of memory! Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+
+        buf->cap = newCap;
+    }
+}
+
+/**
+ * @brief Adds characters to the end of a text buffer.
+ *
+ * @param buf    The text buffer where the characters are added.
+ * @param text   The characters to be added.
+ * @param len    The amount of characters to be added.
+ */
+void
+appendText(TextBuf *buf,
+           char *text,
+           size_t len)
+{
+    if (len > 0)
+    {
+        reserveText(buf, len);
+        memcpy(&buf->data[buf->len], text, len);
+        buf->len += len;
+    }
+}
+
+/**
+ * @brief
+ *    Gets a translator ready for a new text, with no word kept or queued.
+ *
+ * @param ctx   The translator to be reset.
+ */
+void
+resetTranslator(Translator *ctx)
+{
+    ctx->hasWord = 0;
+    ctx->held.len = 0;
+    ctx->isWordOut = 0;
+    ctx->queue.len = 0;
+    ctx->nQueued = 0;
+    ctx->pending.len = 0;
+    ctx->nMissRun = 0;
+    ctx->nSkipLines = 0;
+}
+
+/**
+ * @brief
+ *    Prepares to translate text from a source language to a target language
+ *    using the entries of a dictionary.
+ *
+ * @param ctx          The translator to be initialized.
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param sourceLang    The (title case) language of the text.
+ * @param destLang      The (title case) language to be translated to.
+ * @param keepsFormat   1 if the symbols and spacing of the text are kept
+ *                      around the translations (for documents), 0 if the
+ *                      symbols are removed and the words of each line are
+ *                      separated by single spaces.
+ *
+ * @pre   The dictionary is not changed while the translator is used.
+ * @pre   No other thread is using the dictionary (a translator can be
+ *        copied with forkTranslator() to be used by other threads instead,
+ *        each with a translation memory of its own).
+ * @post  The translator is freed with freeTranslator().
+ */
+void
+initTranslator(Translator *ctx,
+               Dictionary *dict,
+               char *sourceLang,
+               char *destLang,
+               int keepsFormat)
+{
+    ctx->dict = dict;
+    ctx->memory = &dict->memory;
+
+    // languages that are not in the table yet have no translations
+    ctx->nSourceLang = findLang(&dict->langs, sourceLang);
+    ctx->nDestLang = findLang(&dict->langs, destLang);
+    refreshLangGraph(dict);
+    ctx->nPivotLang = getPivotLang(dict, ctx->nSourceLang, ctx->nDestLang);
+    ctx->arrTable = NULL;
+    ctx->keepsFormat = keepsFormat;
+
+    // no word (or phrase) longer than the longest string has a translation
+    ctx->nMaxLen = dict->strings.nMaxLen;
+    ctx->nMaxSpan = ctx->nMaxLen + MAX_SPAN_LEN;
+    initTextBuf(&ctx->held);
+    initTextBuf(&ctx->queue);
+    initTextBuf(&ctx->pending);
+    ctx->spans = NULL;
+    ctx->nSpanCap = 0;
+    resetTranslator(ctx);
+}
+
+/**
+ * @brief
+ *    Copies a translator for another thread, which translates between the
+ *    same languages with buffers (and a translation memory) of its own.
+ *
+ * @param ctx      The translator to be initialized.
+ * @param start    The translator to be copied.
+ * @param memory   The translation memory of the copy.
+ *
+ * @post  The copy is freed with freeTranslator().
+ */
+void
+forkTranslator(Translator *ctx,
+               Translator *start,
+               TransMemory *memory)
+{
+    *ctx = *start;
+    ctx->memory = memory;
+    initTextBuf(&ctx->held);
+    initTextBuf(&ctx->queue);
+    initTextBuf(&ctx->pending);
+    ctx->spans = NULL;
+    ctx->nSpanCap = 0;
+    resetTranslator(ctx);
+}
+
+/**
+ * @brief
+ *    Lets a translator use the table of its languages (see getPairTable())
+ *    for the text it is about to translate, once enough text has been
+ *    translated between them for the table to pay off.
+ *
+ * @param ctx   The translator.
+ * @param len   The amount of characters about to be translated.
+ *
+ * @pre   No other thread is using the dictionary, and the translator is
+ *        forked (see forkTranslator()) only after this.
+ */
+void
+prepareTable(Translator *ctx,
+             size_t len)
+{
+    ctx->arrTable = getPairTable(ctx->dict, ctx->nSourceLang,
+                                 ctx->nDestLang, ctx->nPivotLang,
+                                 len / CHARS_PER_LOOKUP + 1);
+}
+
+/**
+ * @brief Frees the memory used by a translator.
+ *
+ * @param ctx   The translator to be freed.
+ */
+void
+freeTranslator(Translator *ctx)
+{
+    freeTextBuf(&ctx->held);
+    freeTextBuf(&ctx->queue);
+    freeTextBuf(&ctx->pending);
+    free(ctx->spans);
+}
+
+/**
+ * @brief
+ *    Checks if a character is one of the symbols that are removed from the
+ *    text before it is translated.
+ *
+ * @param c   The character to be checked.
+ *
+ * @return
+ *    1   if the character is a symbol.
+ *    0   if not.
+ */
+int
+isSymbol(char c)
+{
+    return c == ',' || c == '.' || c == '!' || c == '?';
+}
+
+#ifdef SCAN_WIDTH
+/**
+ * @brief
+ *    Finds the separators and the symbols (see isSymbol()) in a block of
+ *    SCAN_WIDTH characters of text.
+ *
+ * @param text       The block of characters.
+ * @param pSymbols   The address where the mask of the symbols is stored.
+ *
+ * @return
+ *    The mask of the separators (a space, "\r" or "\n"), with bit i set if
+ *    text[i] is one.
+ */
+unsigned int
+scanBlock(char *text,
+          unsigned int *pSymbols)
+{
+#if defined(__AVX2__)
+    __m256i block = _mm256_loadu_si256((__m256i *)text);
+    __m256i seps, syms;
+
+    seps = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')),
+                        _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r'))),
+        _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')));
+    syms = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(',')),
+                        _mm256_cmpeq_epi8(block, _mm256_set1_epi8('.'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('!')),
+                        _mm256_cmpeq_epi8(block, _mm256_set1_epi8('?'))));
+    *pSymbols = (unsigned int)_mm256_movemask_epi8(syms);
+
+    return (unsigned int)_mm256_movemask_epi8(seps);
+#else
+    __m128i block = _mm_loadu_si128((__m128i *)text);
+    __m128i seps, syms;
+
+    seps = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block,
+                                                    _mm_set1_epi8(' ')),
+                                     _mm_cmpeq_epi8(block,
+                                                    _mm_set1_epi8('\r'))),
+                        _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    syms = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block,
+                                                    _mm_set1_epi8(',')),
+                                     _mm_cmpeq_epi8(block,
+                                                    _mm_set1_epi8('.'))),
+                        _mm_or_si128(_mm_cmpeq_epi8(block,
+                                                    _mm_set1_epi8('!')),
+                                     _mm_cmpeq_epi8(block,
+                                                    _mm_set1_epi8('?'))));
+    *pSymbols = (unsigned int)_mm_movemask_epi8(syms);
+
+    return (unsigned int)_mm_movemask_epi8(seps);
+#endif
+}
+#endif
+
+/**
+ * @brief
+ *    Finds where the word at the start of some text ends, in the same pass
+ *    finding its symbols (see isSymbol()) and copying the characters that
+ *    are not symbols (the key the word is looked up by). Each block of the
+ *    word is copied a run of characters between its symbols at a time, so
+ *    a word without symbols is copied whole.
+ *
+ * @param text      The characters of the text (not null-terminated),
+ *                  starting with the word.
+ * @param len       The amount of characters in the text.
+ * @param key       The array where the characters of the word that are not
+ *                  symbols are stored (not null-terminated).
+ * @param nKeyCap   The most characters stored in key; the rest are only
+ *                  counted.
+ * @param scan      The address where the length of the word, the start and
+ *                  end of the word without its leading and trailing symbols
+ *                  (both the length of the word if it is only made of
+ *                  symbols), and the amount of characters that are not
+ *                  symbols are stored.
+ *
+ * @return
+ *    The amount of characters in the word, up to the first separator (a
+ *    space, "\r" or "\n") or the end of the text.
+ */
+size_t
+scanWord(char *text,
+         size_t len,
+         char *key,
+         size_t nKeyCap,
+         WordScan *scan)
+{
+    size_t i = 0, nRun;
+    size_t nClean = 0, nLead = 0, nTail = 0;
+    int isFound = 0;
+    int hasCore = 0;
+#ifdef SCAN_WIDTH
+    unsigned int nSeps, nSyms, nCore, nBit;
+    unsigned long long nRunBits;
+
+    while (!isFound && i + SCAN_WIDTH <= len)
+    {
+        // the characters of the word (up to the separator) that are not
+        // symbols
+        nSeps = scanBlock(&text[i], &nSyms);
+        nCore = (unsigned int)((1ull << SCAN_WIDTH) - 1) & ~nSyms;
+        if (nSeps != 0)
+            nCore &= (nSeps & (0u - nSeps)) - 1;
+
+        if (nCore != 0)
+        {
+            if (!hasCore)
+                nLead = i + __builtin_ctz(nCore);
+            nTail = i + 32 - __builtin_clz(nCore);
+            hasCore = 1;
+        }
+
+        while (nCore != 0)
+        {
+            nBit = __builtin_ctz(nCore);
+            nRunBits = (unsigned long long)nCore >> nBit;
+            nRun = __builtin_ctzll(~nRunBits);
+            if (nClean < nKeyCap)
+                memcpy(&key[nClean], &text[i + nBit],
+                       nRun < nKeyCap - nClean ? nRun : nKeyCap - nClean);
+
+            nClean += nRun;
+            nCore &= ~(unsigned int)(((1ull << nRun) - 1) << nBit);
+        }
+
+        if (nSeps != 0)
+        {
+            i += __builtin_ctz(nSeps);
+            isFound = 1;
+        }
+        else
+        {
+            i += SCAN_WIDTH;
+        }
+    }
+#endif
+
+    while (!isFound && i < len)
+    {
+        if (text[i] == ' ' || text[i] == '\r' || text[i] == '\n')
+        {
+            isFound = 1;
+        }
+        else
+        {
+            if (!isSymbol(text[i]))
+            {
+                if (!hasCore)
+                    nLead = i;
+                nTail = i + 1;
+                if (nClean < nKeyCap)
+                    key[nClean] = text[i];
+                nClean++;
+                hasCore = 1;
+            }
+
+            i++;
+        }
+    }
+
+    // a word that is only made of symbols has nothing between them
+    if (!hasCore)
+    {
+        nLead = i;
+        nTail = i;
+    }
+
+    scan->len = i;
+    scan->nLead = nLead;
+    scan->nTail = nTail;
+    scan->nClean = nClean;
+
+    return i;
+}
+
+/**
+ * @brief
+ *    Writes a word (or its translation) to the output, separated by a space
+ *    from the word before it on the same line.
+ *
+ * @param ctx    The translator.
+ * @param text   The characters to be written.
+ * @param len    The amount of characters to be written.
+ * @param out    The text buffer where the characters are added.
+ */
+void
+writeWord(Translator *ctx,
+          char *text,
+          size_t len,
+          TextBuf *out)
+{
+    reserveText(out, len + 1);
+    if (ctx->hasWord)
+        out->data[out->len++] = ' ';
+
+    memcpy(&out->data[out->len], text, len);
+    out->len += len;
+    ctx->hasWord = 1;
+}
+
+/**
+ * @brief
+ *    Returns the translation of a word (or phrase) of the text, from the
+ *    table of the languages of the translator if it has one (see
+ *    getPairTable()), or from the dictionary if not (see translateTerm()).
+ *
+ * @param ctx    The translator.
+ * @param term   The characters of the word or phrase (not
+ *               null-terminated).
+ * @param len    The amount of characters in the word or phrase.
+ * @param hash   The hash of the word or phrase (see hashBytes()).
+ *
+ * @return
+ *    The string ID of the translation   if there is one.
+ *    -1                                 if there is none.
+ */
+int
+lookupTerm(Translator *ctx,
+           char *term,
+           size_t len,
+           unsigned int hash)
+{
+    int nId = findHashedString(&ctx->dict->strings, term, (int)len, hash);
+    int nTrans = -1;
+
+    if (nId != -1 && ctx->arrTable != NULL)
+        nTrans = ctx->arrTable[nId];
+    else if (nId != -1)
+        nTrans = translateTerm(ctx->dict, ctx->nSourceLang, nId,
+                               ctx->nDestLang, ctx->nPivotLang);
+
+    return nTrans;
+}
+
+/**
+ * @brief
+ *    Writes words at the front of the queue of a translator that keeps the
+ *    symbols and spacing of the text, as they are in the text or as their
+ *    translation. A phrase keeps the leading symbols of its first word and
+ *    the trailing symbols and separators of its last word; what is between
+ *    its words is replaced along with them.
+ *
+ * @param ctx      The translator.
+ * @param nWords   The amount of words to be written.
+ * @param nTrans   The string ID of the translation of the words, or -1 if
+ *                 there is none (only for a single word).
+ * @param out      The text buffer where the words are added.
+ */
+void
+writeQueued(Translator *ctx,
+            int nWords,
+            int nTrans,
+            TextBuf *out)
+{
+    WordSpan *first = &ctx->spans[0];
+    WordSpan *last = &ctx->spans[nWords - 1];
+
+    if (nTrans != -1)
+    {
+        appendText(out, ctx->pending.data, first->nCore);
+        appendText(out, getString(&ctx->dict->strings, nTrans),
+                   getStringLen(&ctx->dict->strings, nTrans));
+        appendText(out, &ctx->pending.data[last->nTail],
+                   last->nEnd - last->nTail);
+    }
+    else
+    {
+        appendText(out, ctx->pending.data, last->nEnd);
+    }
+}
+
+/**
+ * @brief
+ *    Removes words from the front of the queue of a translator (and from
+ *    its pending text), moving the words that are left to the front.
+ *
+ * @param ctx      The translator.
+ * @param nWords   The amount of words to be removed.
+ */
+void
+dropQueued(Translator *ctx,
+           int nWords)
+{
+    int nKeyDone = ctx->spans[nWords - 1].nKeyEnd;
+    int nDone = 0;
+    int i;
+
+    // the space before the next word goes with the removed words
+    if (nWords < ctx->nQueued)
+        nKeyDone++;
+
+    ctx->queue.len -= nKeyDone;
+    memmove(ctx->queue.data, &ctx->queue.data[nKeyDone], ctx->queue.len);
+    if (ctx->keepsFormat)
+    {
+        nDone = ctx->spans[nWords - 1].nEnd;
+        ctx->pending.len -= nDone;
+        memmove(ctx->pending.data, &ctx->pending.data[nDone],
+                ctx->pending.len);
+    }
+    for (i = nWords; i < ctx->nQueued; i++)
+    {
+        ctx->spans[i - nWords].nKeyEnd = ctx->spans[i].nKeyEnd - nKeyDone;
+        ctx->spans[i - nWords].hash = ctx->spans[i].hash;
+        ctx->spans[i - nWords].nStart = ctx->spans[i].nStart - nDone;
+        ctx->spans[i - nWords].nCore = ctx->spans[i].nCore - nDone;
+        ctx->spans[i - nWords].nTail = ctx->spans[i].nTail - nDone;
+        ctx->spans[i - nWords].nEnd = ctx->spans[i].nEnd - nDone;
+    }
+
+    ctx->nQueued -= nWords;
+}
+
+/**
+ * @brief
+ *    Writes the translation of the words at the front of the queue of the
+ *    translator, using the longest phrase (or the single word) that has a
+ *    translation, and removes them from the queue. Words that might still
+ *    be the start of a longer phrase are kept until the words after them
+ *    are known, unless the line has ended.
+ *
+ * @details
+ *    The phrase trie is only used to know which words can continue a
+ *    phrase; each candidate phrase is then looked up like a single word
+ *    (see lookupTerm()), so a stale node in the trie never causes a
+ *    mismatch. The words of a phrase are already separated by single spaces
+ *    in the queue, so a phrase is looked up where it is.
+ *
+ * @param ctx     The translator.
+ * @param out     The text buffer where the translations are added.
+ * @param isEnd   1 if no more words follow on the line, 0 if not.
+ */
+void
+resolveQueue(Translator *ctx,
+             TextBuf *out,
+             int isEnd)
+{
+    PhraseTrie *trie = &ctx->dict->phrases;
+    WordSpan *spans;
+    char *queue;
+    int nNode, nNext, nDepth, nWordStart;
+    int nFound;
+    int k;
+    int over = 0;
+
+    while (ctx->nQueued > 0 && !over)
+    {
+        queue = ctx->queue.data;
+        spans = ctx->spans;
+
+        // follow the trie through the queued words
+        nNode = getPhraseRoot(ctx->nSourceLang);
+        nDepth = 0;
+        nNext = findPhraseChild(trie, nNode, queue, spans[0].nKeyEnd,
+                                spans[0].hash);
+        while (nNext != -1)
+        {
+            nNode = nNext;
+            nDepth++;
+            nNext = -1;
+            if (nDepth < ctx->nQueued)
+            {
+                nWordStart = spans[nDepth - 1].nKeyEnd + 1;
+                nNext = findPhraseChild(trie, nNode, &queue[nWordStart],
+                                        spans[nDepth].nKeyEnd - nWordStart,
+                                        spans[nDepth].hash);
+            }
+        }
+
+        // wait for the next word if it could make a longer phrase
+        if (!isEnd && nDepth == ctx->nQueued &&
+            trie->nodes[nNode].nChildren > 0)
+        {
+            over = 1;
+        }
+        else
+        {
+            // try the longest phrase first, down to two words
+            nFound = -1;
+            k = nDepth;
+            while (nFound == -1 && k >= 2)
+            {
+                if (spans[k - 1].nKeyEnd <= ctx->nMaxLen)
+                    nFound = lookupTerm(ctx, queue, spans[k - 1].nKeyEnd,
+                                        hashBytes(queue,
+                                                  spans[k - 1].nKeyEnd,
+                                                  2166136261u));
+                if (nFound == -1)
+                    k--;
+            }
+
+            // then the first word alone
+            if (nFound == -1)
+            {
+                k = 1;
+                nFound = lookupTerm(ctx, queue, spans[0].nKeyEnd,
+                                    spans[0].hash);
+            }
+
+            // if found, write the translation, if not write the word
+            if (ctx->keepsFormat)
+                writeQueued(ctx, k, nFound, out);
+            else if (nFound != -1)
+                writeWord(ctx, getString(&ctx->dict->strings, nFound),
+                          getStringLen(&ctx->dict->strings, nFound), out);
+            else
+                writeWord(ctx, queue, spans[0].nKeyEnd, out);
+
+            dropQueued(ctx, k);
+        }
+    }
+}
+
+/**
+ * @brief
+ *    Writes separators (or a word that is only made of symbols) as they are
+ *    in the text, for a translator that keeps the symbols and spacing of
+ *    the text. If there are queued words, they are kept after the last one
+ *    until it is written (see writeQueued()).
+ *
+ * @param ctx    The translator.
+ * @param text   The characters to be written (not null-terminated).
+ * @param len    The amount of characters to be written.
+ * @param out    The text buffer where the characters are added.
+ */
+void
+keepSeparators(Translator *ctx,
+               char *text,
+               size_t len,
+               TextBuf *out)
+{
+    // a phrase does not continue across a long run of separators
+    if (ctx->nQueued > 0 && ctx->pending.len + len > (size_t)ctx->nMaxSpan)
+        resolveQueue(ctx, out, 1);
+
+    if (ctx->nQueued > 0)
+    {
+        appendText(&ctx->pending, text, len);
+        ctx->spans[ctx->nQueued - 1].nEnd = ctx->pending.len;
+    }
+    else
+    {
+        appendText(out, text, len);
+    }
+}
+
+/**
+ * @brief
+ *    Finds the word at the start of some text (see scanWord()), copying it
+ *    without its symbols to the end of the queue of a translator, after a
+ *    space if there are queued words, without queuing it yet (see
+ *    queueKey()). Only a word that is not longer than the longest
+ *    translation is copied whole, and hashed, as no longer one can be looked
+ *    up. The hash is used for both the phrase trie and the translations, so
+ *    the word is hashed once (see findHashedString()).
+ *
+ * @param ctx    The translator.
+ * @param text   The characters of the text (not null-terminated), starting
+ *               with the word.
+ * @param len    The amount of characters in the text.
+ * @param scan   The address where what was found is stored.
+ *
+ * @return Returns the copy of the word (not null-terminated).
+ */
+char *
+scanKey(Translator *ctx,
+        char *text,
+        size_t len,
+        WordScan *scan)
+{
+    char *key;
+
+    reserveText(&ctx->queue, (size_t)ctx->nMaxLen + 1);
+    if (ctx->nQueued > 0)
+        ctx->queue.data[ctx->queue.len] = ' ';
+
+    key = &ctx->queue.data[ctx->queue.len + (ctx->nQueued > 0)];
+    scanWord(text, len, key, ctx->nMaxLen, scan);
+    scan->hash = 0;
+    if (scan->nClean <= (size_t)ctx->nMaxLen)
+        scan->hash = hashBytes(key, scan->nClean, 2166136261u);
+
+    return key;
+}
+
+/**
+ * @brief
+ *    Adds the word copied by scanKey() to the queue of a translator.
+ *
+ * @param ctx    The translator.
+ * @param scan   What scanKey() found in the word.
+ *
+ * @return
+ *    Returns where the word is in the queue, with its place in the pending
+ *    text still to be filled in (only if the symbols and spacing of the
+ *    text are kept).
+ */
+WordSpan *
+queueKey(Translator *ctx,
+         WordScan *scan)
+{
+    WordSpan *span;
+
+    ctx->spans = (WordSpan *)growArray(ctx->spans, &ctx->nSpanCap,
+                                       ctx->nQueued + 1, sizeof(WordSpan));
+    ctx->queue.len += (ctx->nQueued > 0) + scan->nClean;
+    span = &ctx->spans[ctx->nQueued++];
+    memset(span, 0, sizeof(WordSpan));
+    span->nKeyEnd = ctx->queue.len;
+    span->hash = scan->hash;
+
+    return span;
+}
+
+/**
+ * @brief
+ *    Translates a single word for a translator that keeps the symbols and
+ *    spacing of the text. The word is looked up without its symbols, and
+ *    its translation is written between the symbols at its start and end.
+ *    A word that has no translation is written as it is.
+ *
+ * @details
+ *    A word that cannot start a phrase is written straight from the text,
+ *    while one that can is copied to the pending text of the translator
+ *    until the words after it are known (see resolveQueue()).
+ *
+ * @param ctx    The translator.
+ * @param word   The characters of the word (not null-terminated).
+ * @param scan   What scanKey() found in the word.
+ * @param key    The word without its symbols, as copied by scanKey().
+ * @param out    The text buffer where the translation is added.
+ */
+void
+translateKeptWord(Translator *ctx,
+                  char *word,
+                  WordScan *scan,
+                  char *key,
+                  TextBuf *out)
+{
+    PhraseTrie *trie = &ctx->dict->phrases;
+    WordSpan *span;
+    size_t len = scan->len, nClean = scan->nClean;
+    size_t nLead = scan->nLead, nTail = scan->nTail;
+    int nTrans;
+
+    if (nClean == 0)
+    {
+        keepSeparators(ctx, word, len, out);
+    }
+    else if (nClean > (size_t)ctx->nMaxLen || len > (size_t)ctx->nMaxSpan ||
+             ctx->nSourceLang == -1 || ctx->nDestLang == -1)
+    {
+        // so is a word with too many symbols to be kept (see holdWord())
+        resolveQueue(ctx, out, 1);
+        appendText(out, word, len);
+        ctx->hasWord = 1;
+    }
+    else
+    {
+        // make room for the word after the queued ones, moving its copy to
+        // the front of the queue
+        if (ctx->nQueued > 0 &&
+            ctx->pending.len + len > (size_t)ctx->nMaxSpan)
+        {
+            resolveQueue(ctx, out, 1);
+            memmove(ctx->queue.data, key, nClean);
+            key = ctx->queue.data;
+        }
+
+        if (ctx->nQueued == 0 &&
+            findPhraseChild(trie, getPhraseRoot(ctx->nSourceLang), key,
+                            nClean, scan->hash) == -1)
+        {
+            nTrans = lookupTerm(ctx, key, nClean, scan->hash);
+            appendText(out, word, nLead);
+            if (nTrans != -1)
+                appendText(out, getString(&ctx->dict->strings, nTrans),
+                           getStringLen(&ctx->dict->strings, nTrans));
+            else
+                appendText(out, &word[nLead], nTail - nLead);
+
+            appendText(out, &word[nTail], len - nTail);
+        }
+        else
+        {
+            span = queueKey(ctx, scan);
+            span->nStart = ctx->pending.len;
+            span->nCore = ctx->pending.len + nLead;
+            span->nTail = ctx->pending.len + nTail;
+            span->nEnd = ctx->pending.len + len;
+            appendText(&ctx->pending, word, len);
+            resolveQueue(ctx, out, 0);
+        }
+
+        ctx->hasWord = 1;
+    }
+}
+
+/**
+ * @brief
+ *    Translates a single word. The symbols in the word are removed first,
+ *    and a word that is only made of symbols is skipped. The word is queued
+ *    in case it starts or continues a phrase (see resolveQueue()), while a
+ *    word that is too long to have a translation is written as it is.
+ *
+ * @param ctx    The translator.
+ * @param word   The characters of the word (not null-terminated).
+ * @param scan   What scanKey() found in the word.
+ * @param key    The word without its symbols, as copied by scanKey().
+ * @param out    The text buffer where the translation is added.
+ */
+void
+translateWord(Translator *ctx,
+              char *word,
+              WordScan *scan,
+              char *key,
+              TextBuf *out)
+{
+    size_t nClean = scan->nClean;
+    WordScan whole;
+
+    // languages that are not in the dictionary have no translations, so
+    // the word is only queued if it could have one
+    if (ctx->keepsFormat)
+    {
+        translateKeptWord(ctx, word, scan, key, out);
+    }
+    else if (nClean == 0)
+    {
+        // the word is skipped
+    }
+    else if (nClean <= (size_t)ctx->nMaxLen && ctx->nSourceLang != -1 &&
+             ctx->nDestLang != -1)
+    {
+        queueKey(ctx, scan);
+        resolveQueue(ctx, out, 0);
+    }
+    else
+    {
+        // the words before it can no longer be part of a phrase with it
+        resolveQueue(ctx, out, 1);
+
+        // write the whole word without its symbols, since its key was only
+        // copied up to the length of the longest translation
+        reserveText(out, nClean + 1);
+        if (ctx->hasWord)
+            out->data[out->len++] = ' ';
+
+        scanWord(word, scan->len, &out->data[out->len], nClean, &whole);
+        out->len += nClean;
+        ctx->hasWord = 1;
+    }
+}
+
+/**
+ * @brief
+ *    Keeps the part of a word at the end of a part of the text, until the
+ *    rest of the word is known (see translateBuffer()). A word that becomes
+ *    longer than the longest translation is written out as it goes, so it
+ *    is never kept whole (nor with more than MAX_SPAN_LEN symbols, if the
+ *    symbols of the text are kept).
+ *
+ * @param ctx    The translator.
+ * @param word   The characters of the part of the word.
+ * @param len    The amount of characters in the part of the word.
+ * @param out    The text buffer where a long word is added.
+ */
+void
+holdWord(Translator *ctx,
+         char *word,
+         size_t len,
+         TextBuf *out)
+{
+    size_t i;
+    size_t nClean = 0;
+
+    // the word is kept with its symbols while it can still be translated
+    for (i = 0; i < ctx->held.len && ctx->keepsFormat && !ctx->isWordOut;
+         i++)
+    {
+        nClean += !isSymbol(ctx->held.data[i]);
+    }
+
+    for (i = 0; i < len && ctx->keepsFormat && !ctx->isWordOut; i++)
+    {
+        nClean += !isSymbol(word[i]);
+    }
+
+    if (ctx->keepsFormat && !ctx->isWordOut &&
+        (ctx->held.len + len > (size_t)ctx->nMaxSpan ||
+         nClean > (size_t)ctx->nMaxLen))
+    {
+        resolveQueue(ctx, out, 1);
+        appendText(out, ctx->held.data, ctx->held.len);
+        ctx->held.len = 0;
+        ctx->isWordOut = 1;
+        ctx->hasWord = 1;
+    }
+
+    if (ctx->keepsFormat && ctx->isWordOut)
+        appendText(out, word, len);
+    else if (ctx->keepsFormat)
+        appendText(&ctx->held, word, len);
+
+    for (i = 0; i < len && !ctx->keepsFormat; i++)
+    {
+        if (isSymbol(word[i]))
+        {
+            // symbols are removed from the word
+        }
+        else if (ctx->isWordOut)
+        {
+            appendText(out, &word[i], 1);
+        }
+        else if (ctx->held.len < (size_t)ctx->nMaxLen)
+        {
+            appendText(&ctx->held, &word[i], 1);
+        }
+        else
+        {
+            // the word can no longer match, so write the queued words and
+            // what was kept
+            resolveQueue(ctx, out, 1);
+            writeWord(ctx, ctx->held.data, ctx->held.len, out);
+            appendText(out, &word[i], 1);
+            ctx->held.len = 0;
+            ctx->isWordOut = 1;
+        }
+    }
+}
+
+/**
+ * @brief
+ *    Translates the word kept by holdWord() now that it has ended.
+ *
+ * @param ctx   The translator.
+ * @param out   The text buffer where the translation is added.
+ */
+void
+finishWord(Translator *ctx,
+           TextBuf *out)
+{
+    WordScan scan;
+    char *key;
+
+    if (ctx->isWordOut)
+    {
+        ctx->isWordOut = 0;
+    }
+    else if (ctx->held.len > 0)
+    {
+        key = scanKey(ctx, ctx->held.data, ctx->held.len, &scan);
+        translateWord(ctx, ctx->held.data, &scan, key, out);
+        ctx->held.len = 0;
+    }
+}
+
+/**
+ * @brief
+ *    Translates a whole line, taking the translation from the translation
+ *    memory if the same words were translated before between the same
+ *    languages, and adding it to the memory if not. The words of the line
+ *    are translated the same way translateBuffer() does.
+ *
+ * @details
+ *    The translation only depends on the words of the line without their
+ *    symbols, so the line is looked up by those words separated by single
+ *    spaces: lines that only differ in their symbols or spacing share a
+ *    translation.
+ *
+ * @param ctx    The translator, at the start of a line.
+ * @param line   The characters of the line (not null-terminated), without
+ *               the line break.
+ * @param len    The amount of characters in the line (at most
+ *               MEMORY_MAX_LINE).
+ * @param out    The text buffer where the translation is added.
+ */
+void
+translateLine(Translator *ctx,
+              char *line,
+              size_t len,
+              TextBuf *out)
+{
+    TransMemory *memory = ctx->memory;
+    MemoryLine *found;
+    char words[MEMORY_MAX_LINE];
+    size_t i, j, nStart = out->len;
+    unsigned int hash;
+    int nLen = 0, nLine;
+    WordScan scan;
+    char *key;
+
+    // the words of a line whose symbols and spacing are kept are the line
+    // as it is
+    if (ctx->keepsFormat)
+    {
+        memcpy(words, line, len);
+        nLen = len;
+    }
+
+    i = 0;
+    while (i < len && !ctx->keepsFormat)
+    {
+        if (line[i] == ' ' || line[i] == '\r')
+        {
+            i++;
+        }
+        else
+        {
+            // a word that is only made of symbols is skipped, and no word
+            // takes more room than it does in the line
+            i += scanWord(&line[i], len - i, &words[nLen + (nLen > 0)],
+                          len - i, &scan);
+            if (scan.nClean > 0 && nLen > 0)
+                words[nLen++] = ' ';
+            nLen += scan.nClean;
+        }
+    }
+
+    hash = hashLine(ctx->nSourceLang, ctx->nDestLang, words, nLen);
+
+    nLine = findMemoryLine(memory, hash, ctx->nSourceLang, ctx->nDestLang,
+                           ctx->keepsFormat, words, nLen);
+    if (nLine != -1)
+    {
+        ctx->nMissRun = 0;
+        memory->nHits++;
+        unlinkMemoryLine(memory, nLine);
+        useMemoryLine(memory, nLine);
+        found = &memory->lines[nLine];
+        appendText(out, &found->words[found->nWordsLen], found->nTransLen);
+    }
+    else
+    {
+        memory->nMisses++;
+    }
+
+    // text with few repeated lines stops paying for the lookups for a
+    // while, but still tries some lines now and then
+    if (nLine == -1 && ++ctx->nMissRun % MEMORY_MISS_RUN == 0)
+        ctx->nSkipLines = MEMORY_SKIP_LINES;
+
+    if (nLine == -1)
+    {
+        i = 0;
+        while (i < len)
+        {
+            if (line[i] == ' ' || line[i] == '\r')
+            {
+                j = i + 1;
+                while (j < len && (line[j] == ' ' || line[j] == '\r'))
+                {
+                    j++;
+                }
+
+                if (ctx->keepsFormat)
+                    keepSeparators(ctx, &line[i], j - i, out);
+                i = j;
+            }
+            else
+            {
+                key = scanKey(ctx, &line[i], len - i, &scan);
+                translateWord(ctx, &line[i], &scan, key, out);
+                i += scan.len;
+            }
+        }
+
+        resolveQueue(ctx, out, 1);
+        addMemoryLine(memory, hash, ctx->nSourceLang, ctx->nDestLang,
+                      ctx->keepsFormat, words, nLen, &out->data[nStart],
+                      (int)(out->len - nStart));
+    }
+
+    ctx->hasWord = out->len > nStart;
+}
+
+/**
+ * @brief
+ *    Translates text word by word and adds it to the output. Words are
+ *    separated by spaces, and the words of each line are written separated
+ *    by a single space (see translateWord()). Phrases of several words are
+ *    translated as a whole, as long as they are on the same line. Line
+ *    breaks are kept, with "\r\n" written as "\n". A line that is whole in
+ *    the text is translated through the translation memory (see
+ *    translateLine()).
+ *
+ * @param ctx       The translator. It keeps track of the current line and of
+ *                  the words that continue in the next part of the text, so
+ *                  text can be translated in parts of any size.
+ * @param text      The text to be translated (not null-terminated).
+ * @param len       The amount of characters in the text.
+ * @param isFinal   1 if this is the end of the text, 0 if more text follows.
+ * @param out       The text buffer where the translation is added.
+ */
+void
+translateBuffer(Translator *ctx,
+                char *text,
+                size_t len,
+                int isFinal,
+                TextBuf *out)
+{
+    TransMemory *memory = ctx->memory;
+    size_t i = 0, j;
+    char *lineEnd, *key;
+    int isLineStart;
+    WordScan scan;
+
+    while (i < len)
+    {
+        // a whole line that is not too long is looked up in the
+        // translation memory first, as long as nothing of it was written
+        lineEnd = NULL;
+        isLineStart = text[i] != ' ' && text[i] != '\r' && text[i] != '\n' &&
+                      !ctx->hasWord && ctx->nQueued == 0 &&
+                      ctx->held.len == 0 && !ctx->isWordOut &&
+                      ctx->nSourceLang != -1 && ctx->nDestLang != -1 &&
+                      memory->nMaxLines > 0;
+        if (isLineStart && ctx->nSkipLines > 0)
+        {
+            ctx->nSkipLines--;
+        }
+        else if (isLineStart)
+        {
+            j = len - i < MEMORY_MAX_LINE + 1 ? len - i : MEMORY_MAX_LINE + 1;
+            lineEnd = (char *)memchr(&text[i], '\n', j);
+            if (lineEnd == NULL && isFinal && len - i <= MEMORY_MAX_LINE)
+                lineEnd = &text[len];
+        }
+
+        if (lineEnd != NULL)
+        {
+            translateLine(ctx, &text[i], lineEnd - &text[i], out);
+            i = lineEnd - text;
+        }
+        else if (text[i] == ' ' || text[i] == '\r' || text[i] == '\n')
+        {
+            // a word from the previous part of the text ends here
+            if (ctx->held.len > 0 || ctx->isWordOut)
+                finishWord(ctx, out);
+
+            if (text[i] == '\n')
+            {
+                resolveQueue(ctx, out, 1);
+                appendText(out, "\n", 1);
+                ctx->hasWord = 0;
+                i++;
+            }
+            else if (ctx->keepsFormat)
+            {
+                j = i + 1;
+                while (j < len && (text[j] == ' ' || text[j] == '\r'))
+                {
+                    j++;
+                }
+
+                keepSeparators(ctx, &text[i], j - i, out);
+                i = j;
+            }
+            else
+            {
+                i++;
+            }
+        }
+        else
+        {
+            key = scanKey(ctx, &text[i], len - i, &scan);
+            j = i + scan.len;
+
+            // keep a word that may continue in the next part of the text,
+            // or that continues one from the previous part
+            if ((j == len && !isFinal) || ctx->held.len > 0 || ctx->isWordOut)
+            {
+                holdWord(ctx, &text[i], j - i, out);
+                if (j < len)
+                    finishWord(ctx, out);
+            }
+            else
+            {
+                translateWord(ctx, &text[i], &scan, key, out);
+            }
+
+            i = j;
         }
     }
 
-    return nReturn;
+    if (isFinal)
+    {
+        finishWord(ctx, out);
+        resolveQueue(ctx, out, 1);
+    }
 }
 
 /**
- * @brief This function gets filename input from the user.
+ * @brief
+ *    Translates many words (or phrases) from a source language to a target
+ *    language in one call, such as a vocabulary list. Each word is looked up
+ *    as a whole, the same way the Translate Feature looks up a single word
+ *    (see translateTerm()).
  *
- * @param filename   The string variable where the filename will be stored.
+ * @details
+ *    Each word is hashed once to find its string ID (see findString()).
+ *    Since the IDs are dense, the words are grouped by ID through a table
+ *    indexed by it, so a word is looked up in the word index only the first
+ *    time it appears, and the whole call takes time linear in the amount of
+ *    words and distinct strings instead of a search for every word. The
+ *    table of the languages is used instead once it pays off (see
+ *    getPairTable()), so later calls skip the lookups altogether.
+ *
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param sourceLang   The (title case) language of the words.
+ * @param destLang     The (title case) language to be translated to.
+ * @param words        The (lowercase) words to be translated.
+ * @param nWords       The amount of words.
+ * @param arrTrans     The array where the translation of each word is
+ *                     stored (NULL if it has none). The translations are
+ *                     only valid until the dictionary is changed.
+ *
+ * @return Returns the amount of words that have a translation.
  */
-void
-getFileName(String30 filename)
+int
+translateWords(Dictionary *dict,
+               char *sourceLang,
+               char *destLang,
+               char *words[],
+               int nWords,
+               char *arrTrans[])
 {
-    String35 tempFile; // temporary filename string
-    int fileExtIsPresent = 0;
-    int hasInvalidChars = 0;
-
-    int over = 0;
-    while (!over)
+    int nSourceLang = findLang(&dict->langs, sourceLang);
+    int nDestLang = findLang(&dict->langs, destLang);
+    int nPivotLang;
+    int *arrFound; // string ID of the translation of each string ID
+    int *arrMemo = NULL;
+    int i, nId;
+    int nTranslated = 0;
+
+    refreshLangGraph(dict);
+    nPivotLang = getPivotLang(dict, nSourceLang, nDestLang);
+    arrFound = getPairTable(dict, nSourceLang, nDestLang, nPivotLang,
+                            (size_t)nWords);
+
+    // -2 until the string is looked up, then -1 if it has no translation
+    if (arrFound == NULL)
     {
-        displayDivider();
-        printf("Enter filename (maximum of 30 characters including ");
-        printf("file extension).\n");
-
-        // guarantees that the string is 5 chars long and <= MAX_FILE_LEN
-        getStrInput(tempFile, 5, MAX_FILE_LEN + 1);
-
-        fileExtIsPresent = isExtPresent(tempFile); // needs to be true
-        hasInvalidChars = isInvCharPres(tempFile); // needs to be false
-
-        if (!fileExtIsPresent)
+        arrMemo = (int *)malloc((dict->strings.nStrings + 1) * sizeof(int));
+        if (arrMemo == NULL)
         {
-            printf("\nInput has no/incorrect file extension. ");
-            printf("Please include the file extension for text ");
-            printf("files (.txt).\n");
+            printf("Out of memory! Exiting...\n");
+            exit(EXIT_FAILURE);
         }
-        else if (hasInvalidChars)
+
+        for (i = 0; i < dict->strings.nStrings; i++)
         {
-            printf("\nInput has invalid characters for filenames. ");
-            printf("Filenames should not have these characters:\n");
-            printf("\\ / : * ? \" < > | \n");
+            arrMemo[i] = -2;
         }
-        else
+
+        arrFound = arrMemo;
+    }
+
+    for (i = 0; i < nWords; i++)
+    {
+        // languages that are not in the dictionary have no translations
+        nId = -1;
+        if (nSourceLang != -1 && nDestLang != -1)
+            nId = findString(&dict->strings, words[i], strlen(words[i]));
+
+        if (nId != -1 && arrFound[nId] == -2)
+            arrFound[nId] = translateTerm(dict, nSourceLang, nId, nDestLang,
+                                          nPivotLang);
+
+        arrTrans[i] = NULL;
+        if (nId != -1 && arrFound[nId] != -1)
         {
-            over = 1;
+            arrTrans[i] = getString(&dict->strings, arrFound[nId]);
+            nTranslated++;
         }
     }
 
-    // assign temporary variable to official variable
-    strcpy(filename, tempFile);
+    free(arrMemo);
+
+    return nTranslated;
 }
 
 /**
  * @brief
- *    This function removes symbols from the given string. The symbols to be
- *    removed include the exclamation point (!), question mark (?), comma (,),
- *    and period (.).
+ *    Displays how many lines were found in the translation memory (see
+ *    translateLine()) and how many had to be translated word by word.
  *
- * @param strText   The string where the text that the user wants to translate
- *                  is stored.
+ * @param fp       The stream where the counts are written.
+ * @param memory   The translation memory.
  */
 void
-removeSymbols(String150 strText)
+displayMemoryStats(FILE *fp,
+                   TransMemory *memory)
 {
-    int i = 0; // iterates through the string
-    int j = 0; // how many non-symbol characters there are
-
-    while (strText[i] != '\0')
-    {
-        // if the current character is not a symbol, it is retained in
-        // the string, while symbols are skipped
-        if (strText[i] != ',' && strText[i] != '.' && strText[i] != '!' &&
-            strText[i] != '?')
-        {
-            strText[j] = strText[i];
-            j++;
-        }
-
-        i++;
-    }
+    unsigned long nLookups = memory->nHits + memory->nMisses;
 
-    // null-terminate the string
-    strText[j] = '\0';
+    fprintf(fp, "Translation memory: %lu hits, %lu misses (%.1f%% hit rate)\n",
+            memory->nHits, memory->nMisses,
+            nLookups > 0 ? 100.0 * memory->nHits / nLookups : 0.0);
 }
 
 /**
  * @brief
- *    This function encompasses the Add Entry Feature of the the
- *    Manage Data Menu.
- *
- * @param entries         Array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nEntryCount     The current number entries in the entry list.
- * @param nManageChoice   The integer of the user's choice in the Manage Data
- * Menu.
+ *    This function encompasses the Translate Feature of the Translate Menu.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (amount of choices in the
- *        Manage Data Menu).
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs.
  */
 void
-addEntryFeat(Entry *entries, 
-             int *nEntryCount, 
-             int nManageChoice)
+translateFeat(Dictionary *dict)
 {
-    int nMatches;
-    int arrMatched[MAX_ENTRIES]; // array to store the indices of
-                                 // the matched entries
-    int pairIsInEntry;
-    int addEntry = 1; // assume that there will be no matches later
-    String20 tempLangVar, tempTransVar;
+    char *sourceLang, *destLang;
+    String150 strText;
 
-    // just exit immediately if max amount of entries has been reached
-    if (*nEntryCount >= MAX_ENTRIES)
-    {
-        displayMaxMsg(nManageChoice);
-        return;
-    }
+    Translator ctx;
+    TextBuf out;
+    int over = 0;
 
-    // obtain "source" language-translation pair from the user
-    getLangTrans(tempLangVar, tempTransVar);
+    // obtain the source and destination languages of the text
+    getLang(&sourceLang, 1);
+    getLang(&destLang, 2);
 
-    // find pair only in the "source" language-translation pairs of entries
-    pairIsInEntry = findPairInAllEntries(tempLangVar, tempTransVar, 
-                                         *nEntryCount, entries, arrMatched,
-                                         &nMatches, 0, 0);
+    initTranslator(&ctx, dict, sourceLang, destLang, 0);
+    initTextBuf(&out);
 
-    if (pairIsInEntry)
+    while (!over)
     {
-        displayMEntries(entries, arrMatched, nMatches, nManageChoice);
+        displayDivider();
+        printf("Enter Text (maximum of 150 characters).\n");
+        getStrInput(strText, 1, MAX_TEXT_LEN + 1);
 
-        // ask the user if they want to create a new entry
-        addEntry = isNewEntry();
-    }
+        printf("\nTranslated Text:\n");
+
+        // each text is translated as a line of its own
+        out.len = 0;
+        ctx.hasWord = 0;
+        prepareTable(&ctx, strlen(strText));
+        translateBuffer(&ctx, strText, strlen(strText), 1, &out);
+        printf("%.*s\n", (int)out.len, out.data);
 
-    // create an entry if there were no matching entries earlier or
-    // if there were, the user chose to create another one
-    if (addEntry)
-    {
-        // add the lang-trans pair earlier as the "source" pair
-        assignNewEntries(entries, *nEntryCount, tempLangVar, tempTransVar);
         displayDivider();
-        printf("Format (Language: Translation)\n");
-        displayCurrent(entries, *nEntryCount, nManageChoice);
 
-        // user must enter at least one "dest/target" language-translation pair
-        // after that, the user may or may not enter more language-translation
-        // pairs
-        addMoreTrans(entries, *nEntryCount, nManageChoice);
-        *nEntryCount += 1;
+        printf("Do you want to translate another text from the same ");
+        printf("source and target languages? ");
+        over = !getUserConfirmation();
     }
+
+    freeTranslator(&ctx);
+    freeTextBuf(&out);
+    free(sourceLang);
+    free(destLang);
+
+    displayDivider();
+    displayMemoryStats(stdout, &dict->memory);
+    printf("Going back to the Translate Menu now...\n");
 }
 
 /**
  * @brief
- *    This function encompasses the Add Translation Feature of the the
- *    Manage Data Menu.
+ *    Reads the whole contents of a file into memory.
  *
- * @param entries         Array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nEntryCount     The current number entries in the entry list.
- * @param nManageChoice   The integer of the user's choice in the
- *                        Manage Data Menu.
+ * @param fp     The file to be read, opened for reading.
+ * @param pLen   The address where the amount of characters read is stored.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
- *        Manage Data Menu).
+ * @return
+ *    The contents of the file (not null-terminated), which must be freed
+ *    by the caller.
  */
-void
-addTransFeat(Entry *entries, 
-             int nEntryCount, 
-             int nManageChoice)
+char *
+readWholeFile(FILE *fp,
+              size_t *pLen)
 {
-    int nEntryChoice, nMatches;
-    int arrMatched[MAX_ENTRIES]; // array to store the indices of the
-                                 // matched entries
-    String20 tempLangVar, tempTransVar;
-    int pairIsInEntry;
-
-    // obtain "source" lang-trans pair to be searched
-    getLangTrans(tempLangVar, tempTransVar);
-
-    // find pair only in the "source" language-translation pairs of entries
-    pairIsInEntry = findPairInAllEntries(tempLangVar, tempTransVar,
-                                         nEntryCount, entries, arrMatched,
-                                         &nMatches, 0, 0);
-
-    // exit immediately if there are no matches
-    if (!pairIsInEntry)
-    {
-        displayNoneMsg(nManageChoice);
-        return;
-    }
+    TextBuf buf;
+    size_t nRead;
+    long nSize;
 
-    displayMEntries(entries, arrMatched, nMatches, nManageChoice);
+    initTextBuf(&buf);
 
-    // if there are more than 1 match, ask the user which entry they wish
-    // to add lang-trans pairs to; otherwise, immediately start adding
-    // pairs to the sole match
-    if (nMatches > 1)
-    {
-        getEntryChoice(&nEntryChoice, arrMatched, nMatches);
-    }
-    else
-    {
-        nEntryChoice = arrMatched[0];
-    }
+    // allocate the whole file at once if its size is known
+    if (fseek(fp, 0, SEEK_END) == 0 && (nSize = ftell(fp)) > 0 &&
+        fseek(fp, 0, SEEK_SET) == 0)
+        reserveText(&buf, (size_t)nSize + FILE_CHUNK_SIZE);
 
-    // exit the add translation feature if selected entry already reached
-    // the maximum count of pairs
-    if (entries[nEntryChoice].count >= MAX_COUNT)
+    // read until fread() comes up short, so pipes work as well
+    do
     {
-        displayMaxMsg(nManageChoice);
-        return;
-    }
-
-    getLangTrans(tempLangVar, tempTransVar);
-    assignNewEntries(entries, nEntryChoice, tempLangVar, tempTransVar);
-    displayDivider();
-    printf("Format (Language: Translation)\n");
-    displayCurrent(entries, nEntryChoice, nManageChoice);
+        reserveText(&buf, FILE_CHUNK_SIZE);
+        nRead = fread(&buf.data[buf.len], 1, FILE_CHUNK_SIZE, fp);
+        buf.len += nRead;
+    } while (nRead == FILE_CHUNK_SIZE);
 
-    // exit the add translation feature if selected entry already reached
-    // the maximum count of pairs
-    if (entries[nEntryChoice].count >= MAX_COUNT)
-    {
-        displayMaxMsg(nManageChoice);
-        return; // addMoreTrans() will exit early if so, but this is more
-                // explicit
-    }
+    *pLen = buf.len;
 
-    // if the count limit has not been reached, the user may or may not
-    // enter more language-translation pairs
-    addMoreTrans(entries, nEntryChoice, nManageChoice);
+    return buf.data;
 }
 
 /**
  * @brief
- *    This function encompasses the Delete Entry Feature of the the
- *    Manage Data Menu.
+ *    Converts a language given on the command line to title case, where it
+ *    is.
  *
- * @param entries         Array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nEntryCount     The current number entries in the entry list.
- * @param nManageChoice   The integer of the user's choice in the Manage Data
- * Menu.
+ * @param arg   The command-line argument.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
- *        Manage Data Menu).
+ * @return
+ *    1   if the language is valid.
+ *    0   if it is empty.
  */
-void
-deleteEntryFeat(Entry *entries, 
-                int *nEntryCount,
-                int nManageChoice)
+int
+getLangArg(char *arg)
 {
-    int nDelChoice;
-    int inputIsValid;
-
-    // just exit immediately to avoid a huge if block
-    if (*nEntryCount == 0)
-    {
-        displayNoneMsg(nManageChoice);
-        return;
-    }
-
-    displayAllEntries(entries, *nEntryCount, nManageChoice);
+    int nReturn = 0;
 
-    // get the index of the entry that the user wants to delete
-    inputIsValid = getDelChoice(&nDelChoice, *nEntryCount);
-    if (inputIsValid)
+    if (strlen(arg) >= MIN_LANG_LEN)
     {
-        deleteEntry(entries, *nEntryCount, nDelChoice);
-        *nEntryCount -= 1;
-        displayDivider();
-        printf("Entry successfully deleted. ");
-        printf("Going back to the Manage Data Menu now...\n");
+        titleCase(arg);
+        nReturn = 1;
     }
     else
     {
-        displayInvDel();
+        fprintf(stderr, "Invalid language: %s\n", arg);
     }
+
+    return nReturn;
 }
 
 /**
  * @brief
- *    This function encompasses the Delete Translation Feature of the the
- *    Manage Data Menu.
+ *    Loads all the entries of a dictionary file without asking the user,
+ *    for the command-line modes. A file ending in ".snap" is loaded as a
+ *    snapshot (see loadSnapshot()).
  *
- * @param entries         Array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nEntryCount     The current number entries in the entry list.
- * @param nManageChoice   The integer of the user's choice in the
- *                        Manage Data Menu.
+ * @param dict       The (empty) dictionary where the entries are added.
+ * @param filename   The name of the dictionary file.
  *
- * @pre    *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre    nManageChoice is >= 1 and <= 10 (the amount of choices in the
- *         Manage Data Menu).
+ * @return
+ *    1   if the file was loaded.
+ *    0   if it could not be opened.
  */
-void
-deleteTransFeat(Entry *entries, 
-                int *nEntryCount, 
-                int nManageChoice)
+int
+loadDictFile(Dictionary *dict,
+             char *filename)
 {
-    int nDelChoice, nDelIndex;
-    int inputIsValid;
-    int over = 0;
+    ImportStats stats;
 
-    // exit immediately to avoid huge if block
-    if (*nEntryCount == 0)
+    if (isSnapshotFile(filename))
     {
-        displayNoneMsg(nManageChoice);
-        return;
-    }
-
-    displayAllEntries(entries, *nEntryCount, nManageChoice);
+        if (!loadSnapshot(dict, filename))
+        {
+            fprintf(stderr, "Cannot load snapshot: %s\n", filename);
+            return 0;
+        }
 
-    // exit immediately if user input is invalid to avoid huge if block
-    inputIsValid = getDelChoice(&nDelChoice, *nEntryCount);
-    if (!inputIsValid)
-    {
-        displayInvDel();
-        return;
+        return 1;
     }
 
-    displayCurrent(entries, nDelChoice - 1, nManageChoice);
-
-    // loop until the user chooses to stop deleting or until the entry
-    // itself is deleted
-    while (!over)
+    if (!loadEntriesParallel(dict, filename, IMPORT_ACCEPT_ALL, &stats))
     {
-        inputIsValid = getDelIndex(entries, &nDelIndex, nDelChoice);
-
-        // don't force user to enter valid input
-        if (!inputIsValid)
-            return;
-
-        // if the last "dest/target" language-translation pair is deleted,
-        // delete the entry itself
-        if (entries[nDelChoice - 1].count == 2)
-        {
-            deleteEntry(entries, *nEntryCount, nDelChoice);
-            *nEntryCount -= 1;
-
-            printf("\n\nThe whole entry has been deleted. ");
-            printf("Going back to the Manage Data Menu now...\n");
-            over = 1;
-        }
-        else
-        {
-            // if the entry was not deleted, delete the pair and
-            // ask the user if they wish to delete more pairs
-            deleteTrans(entries, nDelChoice, nDelIndex);
-            displayCurrent(entries, nDelChoice - 1, nManageChoice);
-            displayDelAgain();
-            over = !getUserConfirmation();
-        }
+        fprintf(stderr, "Cannot open dictionary file: %s\n", filename);
+        return 0;
     }
-}
 
-/**
- * @brief
- *    This function encompasses the Display All Entries Feature of the the
- *    Manage Data Menu.
- *
- * @param entries         Array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nEntryCount     The current number entries in the entry list.
- * @param nManageChoice   The integer of the user's choice in the
- *                        Manage Data Menu.
- *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
- *        Manage Data Menu).
- */
-void
-displayAllFeat(Entry *entries, 
-               int nEntryCount, 
-               int nManageChoice)
-{
-    if (nEntryCount > 0)
-        displayAllEntries(entries, nEntryCount, nManageChoice);
-    else
-        displayNoneMsg(nManageChoice);
+    return 1;
 }
 
 /**
  * @brief
- *    This function encompasses the Search Word Feature of the the
- *    Manage Data Menu.
+ *    Translates the chunks of a batch job one at a time until there are no
+ *    more chunks left. Each worker thread of the job runs this function.
  *
- * @param entries         Array of structures containing all the entries and
- *                        language-translation pairs.
- * @param nEntryCount     The current number entries in the entry list.
- * @param nManageChoice   The integer of the user's choice in the
- *                        Manage Data Menu.
+ * @details
+ *    Each worker keeps a translation memory of its own, so the threads
+ *    never wait for each other to look up or add a line (see
+ *    translateLine()). Its hits and misses are added to those of the
+ *    dictionary once there are no more chunks.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (the amount of choices in the
- *        Manage Data menu).
+ * @param arg   The batch job (a BatchJob).
+ *
+ * @return Returns NULL.
  */
-void
-searchWordFeat(Entry *entries, 
-               int nEntryCount, 
-               int nManageChoice)
+void *
+batchWorker(void *arg)
 {
-    int nMatches;
-    int arrMatched[MAX_ENTRIES]; // array to store the indices of
-                                 // the matched entries
-    int wordIsInEntry;
-    String20 strKey;
-
-    getKey(strKey);
-
-    // sort entries before searching to avoid mismatch
-    arrangeInterEnt(entries, nEntryCount);
-    arrangeIntraEnt(entries, nEntryCount);
+    BatchJob *job = (BatchJob *)arg;
+    BatchChunk *chunk;
+    Translator ctx;
+    TransMemory memory;
+    int nChunk;
+    int over = 0;
 
-    // find word in all of the language-translation pairs of entries
-    wordIsInEntry = findWordInAllEntries(entries, strKey, nEntryCount,
-                                         arrMatched, &nMatches, 0, -1);
+    initMemory(&memory, job->start.memory->nMaxLines);
+    forkTranslator(&ctx, &job->start, &memory);
 
-    if (wordIsInEntry)
-    {
-        // if the word was found at least once, sort all entries,
-        // then display the matched entries
-        displayMEntries(entries, arrMatched, nMatches, nManageChoice);
-    }
-    else
+    while (!over)
     {
-        // the word is not found in the list of entries
-        displayNoneMsg(nManageChoice);
+        pthread_mutex_lock(&job->lock);
+        nChunk = job->nNext++;
+        pthread_mutex_unlock(&job->lock);
+
+        if (nChunk >= job->nChunks)
+        {
+            over = 1;
+        }
+        else
+        {
+            // every chunk starts on a new line, so it needs no state from
+            // the chunks before it
+            chunk = &job->chunks[nChunk];
+            resetTranslator(&ctx);
+            reserveText(&chunk->out, chunk->len + chunk->len / 8);
+            translateBuffer(&ctx, chunk->text, chunk->len, 1, &chunk->out);
+
+            pthread_mutex_lock(&job->lock);
+            chunk->isDone = 1;
+            pthread_cond_broadcast(&job->done);
+            pthread_mutex_unlock(&job->lock);
+        }
     }
+
+    pthread_mutex_lock(&job->lock);
+    job->start.memory->nHits += memory.nHits;
+    job->start.memory->nMisses += memory.nMisses;
+    pthread_mutex_unlock(&job->lock);
+    freeTranslator(&ctx);
+    freeMemory(&memory);
+
+    return NULL;
 }
 
 /**
  * @brief
- *    This function encompasses the Search Translation Feature of the the
- *    Manage Data Menu.
+ *    Splits text into chunks of about BATCH_CHUNK_SIZE characters that end
+ *    at the end of a line, so the chunks can be translated independently.
  *
- * @param entries          Array of structures containing all the entries and
- *                         language-translation pairs.
- * @param nEntryCount      The current number entries in the entry list.
- * @param nManageChoice    The integer of the user's choice in the
- *                         Manage Data Menu.
+ * @param text      The text to be split.
+ * @param len       The amount of characters in the text.
+ * @param pChunks   The address where the number of chunks is stored.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (the amount of options in the
- *        Manage Data Menu).
+ * @return Returns the chunks, which must be freed by the caller.
  */
-void
-searchTransFeat(Entry *entries, 
-                int nEntryCount, 
-                int nManageChoice)
+BatchChunk *
+splitChunks(char *text,
+            size_t len,
+            int *pChunks)
 {
-    int nMatches;
-    int arrMatched[MAX_ENTRIES]; // array to store the indices of the matched
-                                 // entries
-    int pairIsInEntry;
-    String20 tempLangVar, tempTransVar;
+    BatchChunk *chunks = NULL;
+    int nChunkCap = 0;
+    size_t nStart = 0, nEnd;
+    char *newline;
 
-    getLangTrans(tempLangVar, tempTransVar);
+    *pChunks = 0;
+    while (nStart < len)
+    {
+        // end the chunk after the first line break past its target size
+        nEnd = nStart + BATCH_CHUNK_SIZE;
+        if (nEnd >= len)
+        {
+            nEnd = len;
+        }
+        else
+        {
+            newline = (char *)memchr(&text[nEnd], '\n', len - nEnd);
+            nEnd = newline == NULL ? len : (size_t)(newline - text) + 1;
+        }
 
-    // sort entries before searching to avoid mismatch
-    arrangeInterEnt(entries, nEntryCount);
-    arrangeIntraEnt(entries, nEntryCount);
+        chunks = (BatchChunk *)growArray(chunks, &nChunkCap, *pChunks + 1,
+                                         sizeof(BatchChunk));
+        chunks[*pChunks].text = &text[nStart];
+        chunks[*pChunks].len = nEnd - nStart;
+        initTextBuf(&chunks[*pChunks].out);
+        chunks[*pChunks].isDone = 0;
+        (*pChunks)++;
 
-    // find pair in all of the language-translation pairs of entries
-    pairIsInEntry = findPairInAllEntries(tempLangVar, tempTransVar,
-                                         nEntryCount, entries, arrMatched,
-                                         &nMatches, 0, -1);
+        nStart = nEnd;
+    }
 
-    if (pairIsInEntry)
-        displayMEntries(entries, arrMatched, nMatches, nManageChoice);
-    else
-        displayNoneMsg(nManageChoice);
+    return chunks;
 }
 
 /**
  * @brief
- *    This function encompasses the Export Feature of the the
- *    Manage Data Menu.
+ *    Translates a whole text file without any interaction (the batch mode),
+ *    using the same rules as the Translate Feature, but keeping the symbols
+ *    and spacing of the text (see translateKeptWord()). The file is split into
+ *    chunks of whole lines that are translated by a pool of worker threads,
+ *    while the translated chunks are written in their original order.
  *
- * @param entries          Array of structures containing all the entries and
- *                         language-translation pairs.
- * @param nEntryCount      The current number entries in the entry list.
- * @param nManageChoice    The integer of the user's choice in the
- *                         Manage Data Menu.
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs. It is only read.
+ * @param sourceLang   The (title case) language of the text.
+ * @param destLang     The (title case) language to be translated to.
+ * @param inFile       The name of the file to be translated.
+ * @param outFile      The name of the file where the translation is written.
+ * @param nThreads     The amount of worker threads.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
- * @pre   nManageChoice is >= 1 and <= 10 (the amount of options in the
- *        Manage Data Menu).
+ * @pre   nThreads is >= 1 and <= MAX_THREADS.
+ *
+ * @return
+ *    EXIT_SUCCESS   if the file was translated.
+ *    EXIT_FAILURE   if a file could not be read or written.
  */
-void
-exportFeat(Entry *entries, 
-           int nEntryCount, 
-           int nManageChoice)
+int
+batchTranslate(Dictionary *dict,
+               char *sourceLang,
+               char *destLang,
+               char *inFile,
+               char *outFile,
+               int nThreads)
 {
-    int i, j;
-    FILE *fp_export = NULL;
-    String30 filename;
+    FILE *fp_in, *fp_out;
+    BatchJob job;
+    BatchChunk *chunk;
+    pthread_t threads[MAX_THREADS];
+    char *text;
+    size_t len;
+    int i, nStarted = 0;
+    int nReturn = EXIT_SUCCESS;
+
+    fp_in = fopen(inFile, "rb");
+    if (fp_in == NULL)
+    {
+        fprintf(stderr, "Cannot open input file: %s\n", inFile);
+        return EXIT_FAILURE;
+    }
 
-    // immediately exit if there are no entries to export
-    if (nEntryCount == 0)
+    fp_out = fopen(outFile, "wb");
+    if (fp_out == NULL)
     {
-        displayNoneMsg(nManageChoice);
-        return;
+        fprintf(stderr, "Cannot open output file: %s\n", outFile);
+        fclose(fp_in);
+        return EXIT_FAILURE;
     }
 
-    getFileName(filename);
-    fp_export = fopen(filename, "w");
+    text = readWholeFile(fp_in, &len);
+    fclose(fp_in);
 
-    // exit immediately if file somehow cannot be accessed/written to
-    if (fp_export == NULL)
+    initTranslator(&job.start, dict, sourceLang, destLang, 1);
+    prepareTable(&job.start, len);
+    job.chunks = splitChunks(text, len, &job.nChunks);
+    job.nNext = 0;
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.done, NULL);
+
+    for (i = 0; i < nThreads; i++)
     {
-        printf("Something went wrong! Exiting...\n");
-        return;
+        if (pthread_create(&threads[nStarted], NULL, batchWorker, &job) == 0)
+            nStarted++;
     }
 
-    // write data to file
-    for (i = 0; i < nEntryCount; i++)
+    // fall back to translating in this thread if no thread could start
+    if (nStarted == 0)
+        batchWorker(&job);
+
+    // write each chunk as soon as it and the chunks before it are done
+    for (i = 0; i < job.nChunks; i++)
     {
-        for (j = 0; j < entries[i].count; j++)
+        chunk = &job.chunks[i];
+
+        pthread_mutex_lock(&job.lock);
+        while (!chunk->isDone)
+        {
+            pthread_cond_wait(&job.done, &job.lock);
+        }
+        pthread_mutex_unlock(&job.lock);
+
+        if (nReturn == EXIT_SUCCESS && chunk->out.len > 0 &&
+            fwrite(chunk->out.data, 1, chunk->out.len, fp_out) !=
+            chunk->out.len)
         {
-            fprintf(fp_export, "%s: %s\n", entries[i].lang[j], 
-                    entries[i].trans[j]);
+            fprintf(stderr, "Cannot write output file: %s\n", outFile);
+            nReturn = EXIT_FAILURE;
         }
 
-        fprintf(fp_export, "\n");
+        freeTextBuf(&chunk->out);
     }
 
-    fclose(fp_export);
+    for (i = 0; i < nStarted; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
 
-    displayDivider();
-    printf("File export complete!\n");
+    if (fclose(fp_out) != 0)
+        nReturn = EXIT_FAILURE;
+
+    pthread_cond_destroy(&job.done);
+    pthread_mutex_destroy(&job.lock);
+    freeTranslator(&job.start);
+    free(job.chunks);
+    free(text);
+
+    return nReturn;
 }
 
 /**
  * @brief
- *    This function encompasses the Import Feature of the the Manage Data Menu.
- *    The function sscanf () was used in this function to parse strings.
- *    This topic was self-studied as it is outside the topics discussed in
- *    CCPROG2. Lesson Reference: https://www.youtube.com/watch?v=-7cSmcdMryo
+ *    Translates the standard input to the standard output as it is read
+ *    (the filter mode), one chunk at a time, so that the memory used does
+ *    not depend on the size of the input. Each chunk is whatever has
+ *    arrived so far, and its translation is written right away, so the
+ *    filter can be used interactively. Words split between chunks are
+ *    handled by translateBuffer().
  *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param sourceLang   The (title case) language of the text.
+ * @param destLang     The (title case) language to be translated to.
  *
- * @pre   *nEntryCount is >= 0 and <= MAX_ENTRIES.
+ * @return
+ *    EXIT_SUCCESS   if all of the input was translated.
+ *    EXIT_FAILURE   if the input could not be read or the output written.
  */
-void
-importFeat(Entry *entries, 
-           int *nEntryCount)
+int
+filterTranslate(Dictionary *dict,
+                char *sourceLang,
+                char *destLang)
 {
-    FILE *fp_import = NULL;
-    String30 filename;
-    char lineInput[STR30LEN * 2];
-    int i, j;
-    int dataParsed;
-    int loadEntry;
-
-    // variables for the temporary entry structure
-    Entry tempEntry = {};
-    String20 tempLangVar, tempTransVar;
-
-    i = 1; // amount of entries scanned (not necessarily imported)
-
-    getFileName(filename);
-    displayDivider();
-
-    // exit immediately if file does not exist or cannot be accessed
-    fp_import = fopen(filename, "r");
-    if (fp_import == NULL)
+    Translator ctx;
+    TextBuf out;
+    char *chunk;
+    ssize_t nRead;
+    int isFinal = 0;
+    int nReturn = EXIT_SUCCESS;
+
+    chunk = (char *)malloc(FILE_CHUNK_SIZE);
+    if (chunk == NULL)
     {
-        printf("File does not exist or cannot be accessed.\n");
-        return;
-    }
-    else
-    {
-        printf("File successfully loaded.\n");
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
     }
 
-    // continue reading the file as long as EOF isn't encountered (fgets()
-    // returns NULL) and the maximum amount of entries has not been reached
-    while (fgets(lineInput, STR30LEN * 2, fp_import) != NULL &&
-           *nEntryCount < MAX_ENTRIES)
-    {
-        dataParsed = sscanf(lineInput, "%[^:\n]: %[^:\n]", tempLangVar, 
-                            tempTransVar);
+    initTranslator(&ctx, dict, sourceLang, destLang, 1);
+    initTextBuf(&out);
 
-        // if both the language and translation strings have
-        // been successfully parsed, store them in the temporary variable
-        if (dataParsed == 2 && tempEntry.count < MAX_COUNT)
+    while (!isFinal && nReturn == EXIT_SUCCESS)
+    {
+        // read() returns whatever has arrived so far (such as a line typed
+        // into a pipe), and only returns 0 at the end of the input
+        nRead = read(STDIN_FILENO, chunk, FILE_CHUNK_SIZE);
+        if (nRead == -1 && errno != EINTR)
         {
-            titleCase(tempLangVar);
-            lowercase(tempTransVar);
-            copyLangTLPair(tempEntry.lang[tempEntry.count],
-                           tempEntry.trans[tempEntry.count], 
-                           tempLangVar, tempTransVar);
-            tempEntry.count++;
-
-            // the entry has ended
+            fprintf(stderr, "Cannot read the standard input.\n");
+            nReturn = EXIT_FAILURE;
         }
-        else
+        else if (nRead != -1)
         {
-            // assume the user wants to load the entry
-            loadEntry = 1;
-
-            // display the scanned entry
-            displayDivider();
-            printf("Format (Language: Translation)\n\n");
-            printf("Loaded Entry No. %d\n", i);
-            for (j = 0; j < tempEntry.count; j++)
-            {
-                printf("(%d) %s: %s\n", j + 1, tempEntry.lang[j],
-                                               tempEntry.trans[j]);
-            }
-
-            // ask the user if they wish to import the loaded entry
-            printf("\nDo you want to add the loaded ");
-            printf("entry to your data? ");
-            loadEntry = getUserConfirmation();
-
-            if (loadEntry)
+            isFinal = nRead == 0;
+            out.len = 0;
+            prepareTable(&ctx, (size_t)nRead);
+            translateBuffer(&ctx, chunk, (size_t)nRead, isFinal, &out);
+
+            // what was translated is passed on before waiting for more
+            if (out.len > 0 &&
+                (fwrite(out.data, 1, out.len, stdout) != out.len ||
+                 fflush(stdout) != 0))
             {
-                entries[*nEntryCount] = tempEntry;
-                *nEntryCount += 1;
+                fprintf(stderr, "Cannot write the standard output.\n");
+                nReturn = EXIT_FAILURE;
             }
-
-            i++;                    // increment amount of entries scanned
-            clearEntry(&tempEntry); // prepare temp entry for next entry
         }
     }
 
-    if (*nEntryCount >= MAX_ENTRIES)
-        printf("\nThe maximum amount of entries has already been reached!\n");
+    if (fflush(stdout) != 0)
+        nReturn = EXIT_FAILURE;
 
-    printf("\nFile import complete!\n");
+    freeTranslator(&ctx);
+    freeTextBuf(&out);
+    free(chunk);
 
-    fclose(fp_import);
+    return nReturn;
 }
 
 /**
  * @brief
- *    This function encompasses the Translate Feature of the Translate Menu.
- *    The strtok () function was used in this function to tokenize strings.
- *    This topic was self-studied as it is outside the topics discussed in
- *    CCPROG2. Lesson Reference: https://www.youtube.com/watch?v=-7cSmcdMryo
+ *    Translates a vocabulary list without any interaction (the word list
+ *    mode). Each line of the list is a word or phrase, which is converted to
+ *    lowercase and translated as a whole (see translateWords()). The output
+ *    has the translation of each line on the same line, or an empty line if
+ *    it has none.
  *
- * @param entries       Array of structures containing all the entries and
- *                      language-translation pairs.
- * @param nEntryCount   The current number entries in the entry list.
+ * @param dict         The dictionary containing all the entries and
+ *                     language-translation pairs.
+ * @param sourceLang   The (title case) language of the words.
+ * @param destLang     The (title case) language to be translated to.
+ * @param inFile       The name of the file with the words.
+ * @param outFile      The name of the file where the translations are
+ *                     written.
  *
- * @pre   nEntryCount is >= 0 and <= MAX_ENTRIES.
+ * @return
+ *    EXIT_SUCCESS   if the list was translated.
+ *    EXIT_FAILURE   if a file could not be read or written.
  */
-void
-translateFeat(Entry *entries, 
-              int nEntryCount)
+int
+listTranslate(Dictionary *dict,
+              char *sourceLang,
+              char *destLang,
+              char *inFile,
+              char *outFile)
 {
-    String20 sourceLang, destLang;
-    String150 strText;
+    FILE *fp_in, *fp_out;
+    TextBuf out;
+    char *text;
+    char **words = NULL, **arrTrans;
+    size_t len, i, nStart = 0;
+    int nWords = 0, nWordCap = 0, j;
+    int nReturn = EXIT_SUCCESS;
+
+    fp_in = fopen(inFile, "rb");
+    if (fp_in == NULL)
+    {
+        fprintf(stderr, "Cannot open input file: %s\n", inFile);
+        return EXIT_FAILURE;
+    }
 
-    char *word;
-    int i, j;
-    int over = 0;
-    int found;
-    
-    // obtain the source and destination languages of the text
-    getLang(sourceLang, 1);
-    getLang(destLang, 2);
+    text = readWholeFile(fp_in, &len);
+    fclose(fp_in);
 
-    while (!over)
+    // make room for the end of the last line
+    text = (char *)realloc(text, len + 1);
+    if (text == NULL)
     {
-        displayDivider();
-        printf("Enter Text (maximum of 150 characters).\n");
-        getStrInput(strText, 1, MAX_TEXT_LEN + 1);
-        removeSymbols(strText);
-
-        printf("\nTranslated Text:\n");
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
 
-        // tokenize the first word in the text
-        word = strtok(strText, " ");
+    // the words are lowercase, like the translations, so the whole text is
+    // converted at once
+    foldCase(text, len);
 
-        // until the string has ended, attempt to translate each token
-        while (word != NULL)
+    // end each line in place, without its line break; the last line does
+    // not need to be followed by one
+    for (i = 0; i <= len; i++)
+    {
+        if ((i < len && text[i] == '\n') || (i == len && i > nStart))
         {
-            found = 0;
-            for (i = 0; i < nEntryCount && !found; i++)
-            {
-                // iterate through each entry and check each "source" pairs
-                if (!strcmp(sourceLang, entries[i].lang[0]) &&
-                    !strcmp(word, entries[i].trans[0]))
-                {
-                    // once the "source" pairs have matched, find the matching
-                    // destination pair in the same entry
-                    for (j = 1; j < entries[i].count && !found; j++)
-                    {
-                        // if found, print the translation of that word, if not
-                        // let the system iterate until the last entry
-                        if (!strcmp(destLang, entries[i].lang[j]))
-                        {
-                            printf("%s", entries[i].trans[j]);
-                            found = 1; // stop both loops
-                        }
-                    }
-                }
-                
-                if (!found && i == nEntryCount - 1)
-                {
-                    // if the system has iterated through the last entry
-                    // (nEntryCount - 1) and the matching source and dest.
-                    // pairs have not been found, print the original word
-                    printf("%s", word);
-                }
-            }
+            text[i] = '\0';
+            if (i > nStart && text[i - 1] == '\r')
+                text[i - 1] = '\0';
+
+            words = (char **)growArray(words, &nWordCap, nWords + 1,
+                                       sizeof(char *));
+            words[nWords] = &text[nStart];
+            nWords++;
+            nStart = i + 1;
+        }
+    }
 
-            // tokenize the next word in the text
-            word = strtok(NULL, " ");
+    arrTrans = (char **)malloc((nWords + 1) * sizeof(char *));
+    if (arrTrans == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
 
-            if (word != NULL)
-                printf(" ");
-        }
+    translateWords(dict, sourceLang, destLang, words, nWords, arrTrans);
 
-        printf("\n");
-        displayDivider();
+    initTextBuf(&out);
+    for (j = 0; j < nWords; j++)
+    {
+        if (arrTrans[j] != NULL)
+            appendText(&out, arrTrans[j], strlen(arrTrans[j]));
 
-        printf("Do you want to translate another text from the same ");
-        printf("source and target languages? ");
-        over = !getUserConfirmation();
+        appendText(&out, "\n", 1);
     }
 
-    displayDivider();
-    printf("Going back to the Translate Menu now...\n");
+    fp_out = fopen(outFile, "wb");
+    if (fp_out == NULL)
+    {
+        fprintf(stderr, "Cannot open output file: %s\n", outFile);
+        nReturn = EXIT_FAILURE;
+    }
+    else
+    {
+        if (out.len > 0 && fwrite(out.data, 1, out.len, fp_out) != out.len)
+        {
+            fprintf(stderr, "Cannot write output file: %s\n", outFile);
+            nReturn = EXIT_FAILURE;
+        }
+
+        if (fclose(fp_out) != 0)
+            nReturn = EXIT_FAILURE;
+    }
+
+    freeTextBuf(&out);
+    free(arrTrans);
+    free(words);
+    free(text);
+
+    return nReturn;
 }
 
-int main()
+/**
+ * @brief
+ *    Runs the Main Menu and its submenus until the user exits from the Main
+ *    Menu.
+ *
+ * @param dict   The dictionary containing all the entries and
+ *               language-translation pairs. If it has a journal (see
+ *               openJournal()), its entries are kept when the user exits
+ *               either the Manage Data or the Translate Menu.
+ */
+void
+runMenus(Dictionary *dict)
 {
-    Entry entries[MAX_ENTRIES] = {};
-    int nEntryCount = 0;
     int nMainChoice = 0;
     int nManageChoice, nTransChoice;
     int exitMenu;
@@ -2316,6 +9675,8 @@ int main()
     // loop the system until the user exits from the Main Menu
     while (nMainChoice != 3)
     {
+        reportExport(dict);
+        syncJournal(dict);
         displayMainMenu();
         getMainChoice(&nMainChoice);
 
@@ -2325,36 +9686,38 @@ int main()
             exitMenu = 0;
             while (!exitMenu)
             {
+                reportExport(dict);
+                syncJournal(dict);
                 displayManageMenu();
                 getManageChoice(&nManageChoice);
                 switch (nManageChoice)
                 {
                     case 1:
-                        addEntryFeat(entries, &nEntryCount, nManageChoice);
+                        addEntryFeat(dict, nManageChoice);
                         break;
                     case 2:
-                        addTransFeat(entries, nEntryCount, nManageChoice);
+                        addTransFeat(dict, nManageChoice);
                         break;
                     case 3:
-                        deleteEntryFeat(entries, &nEntryCount, nManageChoice);
+                        deleteEntryFeat(dict, nManageChoice);
                         break;
                     case 4:
-                        deleteTransFeat(entries, &nEntryCount, nManageChoice);
+                        deleteTransFeat(dict, nManageChoice);
                         break;
                     case 5:
-                        displayAllFeat(entries, nEntryCount, nManageChoice);
+                        displayAllFeat(dict, nManageChoice);
                         break;
                     case 6:
-                        searchWordFeat(entries, nEntryCount, nManageChoice);
+                        searchWordFeat(dict, nManageChoice);
                         break;
                     case 7:
-                        searchTransFeat(entries, nEntryCount, nManageChoice);
+                        searchTransFeat(dict, nManageChoice);
                         break;
                     case 8:
-                        exportFeat(entries, nEntryCount, nManageChoice);
+                        exportFeat(dict, nManageChoice);
                         break;
                     case 9:
-                        importFeat(entries, &nEntryCount);
+                        importFeat(dict);
                         break;
                     case 10:
                         exitMenu = 1;
@@ -2369,12 +9732,12 @@ int main()
             while (!exitMenu)
             {
                 // there must be at least one entry before proceeding
-                while (nEntryCount == 0)
+                while (countEntries(dict) == 0)
                 {
                     displayDivider();
                     printf("There must be at least one entry loaded ");
                     printf("to proceed to the Translate Menu.\n");
-                    importFeat(entries, &nEntryCount);
+                    importFeat(dict);
                 }
 
                 displayTransMenu();
@@ -2383,7 +9746,7 @@ int main()
                 switch (nTransChoice)
                 {
                     case 1:
-                        translateFeat(entries, nEntryCount);
+                        translateFeat(dict);
                         break;
                     case 2:
                         exitMenu = 1;
@@ -2393,9 +9756,236 @@ int main()
         }
 
         // clear all entries once the user exits either the
-        // Manage Data or the Translate Menu
-        emptyEntry(entries, &nEntryCount);
+        // Manage Data or the Translate Menu, unless they are kept in a
+        // snapshot
+        if (dict->journal == NULL)
+            emptyEntry(dict);
+    }
+}
+
+/**
+ * @brief Displays how to use the program from the command line.
+ *
+ * @param prog   The name of the program.
+ */
+void
+displayUsage(char *prog)
+{
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "  %s\n", prog);
+    fprintf(stderr, "      Start the interactive menus.\n");
+    fprintf(stderr, "  %s -b DICT SOURCE TARGET INPUT OUTPUT\n", prog);
+    fprintf(stderr, "      Translate the INPUT file from the SOURCE to the ");
+    fprintf(stderr, "TARGET language\n");
+    fprintf(stderr, "      using the entries of the DICT file, and write ");
+    fprintf(stderr, "it to the OUTPUT file.\n");
+    fprintf(stderr, "  %s -j THREADS -b DICT SOURCE TARGET INPUT OUTPUT\n",
+            prog);
+    fprintf(stderr, "      Same as -b, using THREADS worker threads ");
+    fprintf(stderr, "(1 to %d).\n", MAX_THREADS);
+    fprintf(stderr, "  %s -m MEGABYTES ...\n", prog);
+    fprintf(stderr, "      Same as any of the modes, keeping the translation ");
+    fprintf(stderr, "tables of the\n");
+    fprintf(stderr, "      language pairs in use within MEGABYTES (0 to %d, ",
+            MAX_TABLE_MB);
+    fprintf(stderr, "default %d).\n", TABLE_BUDGET >> 20);
+    fprintf(stderr, "  %s -f DICT SOURCE TARGET\n", prog);
+    fprintf(stderr, "      Translate the standard input to the standard ");
+    fprintf(stderr, "output as it is read.\n");
+    fprintf(stderr, "  %s -w DICT SOURCE TARGET INPUT OUTPUT\n", prog);
+    fprintf(stderr, "      Translate each line of the INPUT file as a ");
+    fprintf(stderr, "single word or phrase, and\n");
+    fprintf(stderr, "      write the translations line by line to the ");
+    fprintf(stderr, "OUTPUT file.\n");
+    fprintf(stderr, "  %s -s DICT SNAPSHOT\n", prog);
+    fprintf(stderr, "      Write the entries of the DICT file to a binary ");
+    fprintf(stderr, "SNAPSHOT file\n");
+    fprintf(stderr, "      (ending in %s), which loads instantly in ",
+            SNAP_EXT);
+    fprintf(stderr, "place of DICT.\n");
+    fprintf(stderr, "  %s -c SNAPSHOT\n", prog);
+    fprintf(stderr, "      Check every index and offset inside the ");
+    fprintf(stderr, "SNAPSHOT file, which\n");
+    fprintf(stderr, "      loading it does not do.\n");
+    fprintf(stderr, "  %s -e DICT TEXT\n", prog);
+    fprintf(stderr, "      Write the entries of the DICT file (or snapshot) ");
+    fprintf(stderr, "to a TEXT file and\n");
+    fprintf(stderr, "      report how fast it was written.\n");
+    fprintf(stderr, "  %s -p SNAPSHOT\n", prog);
+    fprintf(stderr, "      Start the interactive menus with the entries ");
+    fprintf(stderr, "of the SNAPSHOT file,\n");
+    fprintf(stderr, "      recording every change in a journal next to it ");
+    fprintf(stderr, "(ending in %s)\n", JOURNAL_EXT);
+    fprintf(stderr, "      so the entries are kept from one run to the ");
+    fprintf(stderr, "next.\n");
+}
+
+/**
+ * @brief
+ *    Runs the program in one of its command-line (non-interactive) modes.
+ *
+ * @param argc   The amount of command-line arguments.
+ * @param argv   The command-line arguments.
+ *
+ * @return Returns the exit status of the program.
+ */
+int
+runCommandLine(int argc,
+               char *argv[])
+{
+    Dictionary dict;
+    char **args = &argv[1]; // the arguments after the options
+    int nArgs = argc - 1;
+    int nThreads = 1;
+    long nMegabytes = TABLE_BUDGET >> 20;
+    int isOption = 1;
+    int isBatch, isFilter, isList, isSnapshot, isCheck, isExport;
+    int isPersistent;
+    ExportStats stats;
+    char *end;
+    int nReturn = EXIT_FAILURE;
+
+    // the amount of threads and the table budget are given before the mode
+    while (nArgs >= 2 && isOption)
+    {
+        if (!strcmp(args[0], "-j"))
+        {
+            nThreads = (int)strtol(args[1], &end, 10);
+            if (*end != '\0' || nThreads < 1 || nThreads > MAX_THREADS)
+                nThreads = 0;
+        }
+        else if (!strcmp(args[0], "-m"))
+        {
+            nMegabytes = strtol(args[1], &end, 10);
+            if (*end != '\0' || nMegabytes < 0 || nMegabytes > MAX_TABLE_MB)
+                nMegabytes = -1;
+        }
+        else
+        {
+            isOption = 0;
+        }
+
+        if (isOption)
+        {
+            args += 2;
+            nArgs -= 2;
+        }
+    }
+
+    isBatch = nArgs == 6 && !strcmp(args[0], "-b");
+    isFilter = nArgs == 4 && !strcmp(args[0], "-f") && nThreads == 1;
+    isList = nArgs == 6 && !strcmp(args[0], "-w") && nThreads == 1;
+    isSnapshot = nArgs == 3 && !strcmp(args[0], "-s") && nThreads == 1 &&
+                 isSnapshotFile(args[2]);
+    isCheck = nArgs == 2 && !strcmp(args[0], "-c") && nThreads == 1 &&
+              isSnapshotFile(args[1]);
+    isExport = nArgs == 3 && !strcmp(args[0], "-e") && nThreads == 1;
+    isPersistent = nArgs == 2 && !strcmp(args[0], "-p") && nThreads == 1 &&
+                   isSnapshotFile(args[1]);
+
+    if (nThreads == 0 || nMegabytes == -1 ||
+        (!isBatch && !isFilter && !isList && !isSnapshot && !isCheck &&
+         !isExport && !isPersistent))
+    {
+        displayUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    initDictionary(&dict);
+    dict.tables.nBudget = (size_t)nMegabytes << 20;
+
+    // the other modes start with DICT SOURCE TARGET
+    if (isPersistent)
+    {
+        if (openJournal(&dict, args[1]))
+        {
+            runMenus(&dict);
+            reportExport(&dict);
+            nReturn = EXIT_SUCCESS;
+            if (!closeJournal(&dict))
+            {
+                fprintf(stderr, "Cannot write snapshot: %s\n", args[1]);
+                nReturn = EXIT_FAILURE;
+            }
+        }
+    }
+    else if (isSnapshot)
+    {
+        if (loadDictFile(&dict, args[1]))
+        {
+            nReturn = EXIT_SUCCESS;
+            if (!exportSnapshot(&dict, args[2]))
+            {
+                fprintf(stderr, "Cannot write snapshot: %s\n", args[2]);
+                nReturn = EXIT_FAILURE;
+            }
+        }
+    }
+    else if (isCheck)
+    {
+        if (verifySnapshot(args[1]))
+        {
+            printf("Snapshot is valid: %s\n", args[1]);
+            nReturn = EXIT_SUCCESS;
+        }
+        else
+        {
+            fprintf(stderr, "Snapshot is damaged: %s\n", args[1]);
+        }
+    }
+    else if (isExport)
+    {
+        if (loadDictFile(&dict, args[1]))
+        {
+            nReturn = EXIT_SUCCESS;
+            if (exportText(&dict, args[2], &stats))
+            {
+                displayExportStats(stderr, &stats);
+            }
+            else
+            {
+                fprintf(stderr, "Cannot write text file: %s\n", args[2]);
+                nReturn = EXIT_FAILURE;
+            }
+        }
+    }
+    else if (getLangArg(args[2]) && getLangArg(args[3]) &&
+             loadDictFile(&dict, args[1]))
+    {
+        if (isBatch)
+        {
+            nReturn = batchTranslate(&dict, args[2], args[3], args[4],
+                                     args[5], nThreads);
+            if (nReturn == EXIT_SUCCESS)
+                displayMemoryStats(stderr, &dict.memory);
+        }
+        else if (isList)
+            nReturn = listTranslate(&dict, args[2], args[3], args[4],
+                                    args[5]);
+        else
+            nReturn = filterTranslate(&dict, args[2], args[3]);
     }
 
+    freeDictionary(&dict);
+
+    return nReturn;
+}
+
+int main(int argc, char *argv[])
+{
+    Dictionary dict;
+
+    // any arguments select one of the non-interactive modes
+    if (argc > 1)
+        return runCommandLine(argc, argv);
+
+    initDictionary(&dict);
+    runMenus(&dict);
+
+    // the last export may still be running
+    waitForExport(&dict);
+    reportExport(&dict);
+    freeDictionary(&dict);
+
     return 0;
-}
\ No newline at end of file
+}
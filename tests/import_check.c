@@ -0,0 +1,344 @@
+/**
+ * @file import_check.c
+ * @brief
+ *    Checks that a dictionary file imported in parallel (see
+ *    loadEntriesParallel()) gives the same dictionary as one read line by
+ *    line (see loadEntries()). Both dictionaries are written as text files,
+ *    as the -e mode does, and the files must be the same.
+ *
+ *    The files that are checked are generated with both "\n" and "\r\n"
+ *    line endings, are several IMPORT_CHUNK_SIZE long, and have an entry
+ *    across every IMPORT_CHUNK_SIZE boundary, so that the split into parts
+ *    (see splitImportChunks()) is exercised. A few of their translations
+ *    are long, and both ways must import them whole. Any dictionary files
+ *    given on the command line are checked as well.
+ *
+ *    From the root of the repository:
+ *        gcc -O2 -pthread -o import_check tests/import_check.c
+ *        ./import_check sample-input.txt
+ */
+
+// the translator is built into the check, without its own main()
+#define main translatorMain
+#include "../main.c"
+#undef main
+
+#define CHECK_CHUNKS   3
+#define CHECK_LF_FILE  "import_check_lf.tmp"
+#define CHECK_CRLF_FILE "import_check_crlf.tmp"
+#define CHECK_SERIAL   "import_check_serial.tmp"
+#define CHECK_PARALLEL "import_check_parallel.tmp"
+
+/**
+ * @brief
+ *    Returns the next number of a fixed sequence of pseudo-random numbers,
+ *    so that the generated files are the same on every machine.
+ *
+ * @param pSeed   The state of the sequence, which is updated.
+ * @param nMax    The amount of numbers to choose from.
+ *
+ * @return Returns a number from 0 to nMax - 1.
+ */
+int
+getRandom(unsigned int *pSeed,
+          int nMax)
+{
+    *pSeed = *pSeed * 1103515245u + 12345u;
+
+    return (int)((*pSeed >> 16) % (unsigned int)nMax);
+}
+
+/**
+ * @brief
+ *    Checks if the characters from nStart to nStart + nLen - 1 of a text
+ *    would touch a multiple of IMPORT_CHUNK_SIZE, where a blank line would
+ *    keep the entry around it from crossing the boundary.
+ *
+ * @param nStart   Where the characters would start.
+ * @param nLen     The amount of characters.
+ *
+ * @return
+ *    1   if they touch a boundary.
+ *    0   if not.
+ */
+int
+isAtChunkBoundary(size_t nStart,
+                  size_t nLen)
+{
+    return nStart / IMPORT_CHUNK_SIZE !=
+           (nStart + nLen) / IMPORT_CHUNK_SIZE ||
+           nStart % IMPORT_CHUNK_SIZE == 0;
+}
+
+/**
+ * @brief
+ *    Adds a random language-translation pair line to a text. The
+ *    translations are taken from a small vocabulary, so that "source" pairs
+ *    repeat for the import policies, and some are in mixed case or have
+ *    several words. A few lines are longer than STR30LEN * 2 characters,
+ *    and a few have a long translation.
+ *
+ * @param buf       The text where the line is added.
+ * @param pSeed     The state of the pseudo-random numbers.
+ * @param newline   The line ending.
+ */
+void
+addRandomPair(TextBuf *buf,
+              unsigned int *pSeed,
+              char *newline)
+{
+    static char *langs[] = {
+        "English", "Tagalog", "cebuano", "SPANISH", "Malay", "Chinese",
+        "Hiligaynon", "Kapampangan", "Greek", "Irish", "Italian"
+    };
+    static char *words[] = {
+        "love", "Mahal", "gugma", "amor", "ai", "expensive", "gui", "mal",
+        "buah-buahan", "prutas", "good morning", "magandang umaga",
+        "charger", "caricabatteri", "luchtaire", "a b c", "WATER", "tubig"
+    };
+    char strLine[STR150LEN];
+    char *space = " ";
+    int nLang = getRandom(pSeed, sizeof(langs) / sizeof(langs[0]));
+    int nWord = getRandom(pSeed, sizeof(words) / sizeof(words[0]));
+    int nVariant = getRandom(pSeed, 20000);
+
+    // the space after the colon is optional, and can be a long run
+    if (nVariant % 4 == 0)
+        space = "";
+    else if (nVariant % 500 == 1)
+        space = "                                                  ";
+
+    if (nVariant < 4)
+        sprintf(strLine, "%s: supercalifragilisticexpialidocious%s",
+                langs[nLang], newline);
+    else
+        sprintf(strLine, "%s:%s%s%d%s", langs[nLang], space, words[nWord],
+                getRandom(pSeed, 50), newline);
+
+    appendText(buf, strLine, strlen(strLine));
+}
+
+/**
+ * @brief
+ *    Generates a dictionary file of CHECK_CHUNKS * IMPORT_CHUNK_SIZE
+ *    characters or more. Entries are ended by one or more blank lines, by
+ *    lines that are not pairs, or by the end of the file (the last entry
+ *    has no line ending), and an entry is always across each boundary.
+ *
+ * @param filename   The name of the file to be written.
+ * @param newline    The line ending ("\n" or "\r\n").
+ *
+ * @return
+ *    1   if the file was written.
+ *    0   if not.
+ */
+int
+generateDictFile(char *filename,
+                 char *newline)
+{
+    static char *separators[] = {"", "", "", "", "----", "  ", "x:", ":y"};
+    TextBuf buf;
+    FILE *fp_dict;
+    unsigned int nSeed = 2022;
+    char strSep[STR30LEN];
+    int i, nPairs;
+    int isWritten;
+
+    initTextBuf(&buf);
+    while (buf.len < CHECK_CHUNKS * IMPORT_CHUNK_SIZE)
+    {
+        nPairs = 1 + getRandom(&nSeed, 6);
+        for (i = 0; i < nPairs; i++)
+        {
+            addRandomPair(&buf, &nSeed, newline);
+        }
+
+        sprintf(strSep, "%s%s", separators[getRandom(&nSeed, 8)], newline);
+        if (getRandom(&nSeed, 4) == 0)
+            strcat(strSep, newline);
+
+        // keep going with the entry until the separator is past a boundary
+        while (isAtChunkBoundary(buf.len, strlen(strSep)))
+        {
+            addRandomPair(&buf, &nSeed, newline);
+        }
+
+        appendText(&buf, strSep, strlen(strSep));
+    }
+
+    addRandomPair(&buf, &nSeed, newline);
+    buf.len -= strlen(newline);
+
+    fp_dict = fopen(filename, "wb");
+    isWritten = fp_dict != NULL &&
+                fwrite(buf.data, 1, buf.len, fp_dict) == buf.len;
+    if (fp_dict != NULL && fclose(fp_dict) != 0)
+        isWritten = 0;
+
+    freeTextBuf(&buf);
+
+    return isWritten;
+}
+
+/**
+ * @brief
+ *    Reads a whole file into memory (see readWholeFile()).
+ *
+ * @param filename   The name of the file.
+ * @param pLen       The address where the size of the file is stored.
+ *
+ * @return
+ *    The contents of the file, which must be freed by the caller.
+ *    NULL if the file could not be opened.
+ */
+char *
+readCheckFile(char *filename,
+              size_t *pLen)
+{
+    FILE *fp_in = fopen(filename, "rb");
+    char *text = NULL;
+
+    if (fp_in != NULL)
+    {
+        text = readWholeFile(fp_in, pLen);
+        fclose(fp_in);
+    }
+
+    return text;
+}
+
+/**
+ * @brief
+ *    Imports a dictionary file both ways with an import policy, writes both
+ *    dictionaries as text files and compares them, along with the amount of
+ *    entries imported in each way.
+ *
+ * @param filename   The name of the dictionary file.
+ * @param nPolicy    How each entry is imported (see loadEntries()).
+ *
+ * @return
+ *    1   if both ways give the same result.
+ *    0   if not.
+ */
+int
+checkImport(char *filename,
+            int nPolicy)
+{
+    Dictionary serial, parallel;
+    ImportStats serialStats, parallelStats;
+    ExportStats stats;
+    FILE *fp_import;
+    char *serialText = NULL, *parallelText = NULL;
+    size_t nSerialLen = 0, nParallelLen = 0;
+    int isSame = 0;
+
+    initDictionary(&serial);
+    initDictionary(&parallel);
+
+    fp_import = fopen(filename, "r");
+    if (fp_import != NULL)
+    {
+        loadEntries(&serial, fp_import, nPolicy, &serialStats);
+        fclose(fp_import);
+
+        if (loadEntriesParallel(&parallel, filename, nPolicy,
+                                &parallelStats) &&
+            exportText(&serial, CHECK_SERIAL, &stats) &&
+            exportText(&parallel, CHECK_PARALLEL, &stats))
+        {
+            serialText = readCheckFile(CHECK_SERIAL, &nSerialLen);
+            parallelText = readCheckFile(CHECK_PARALLEL, &nParallelLen);
+            isSame = serialText != NULL && parallelText != NULL &&
+                     nSerialLen == nParallelLen &&
+                     !memcmp(serialText, parallelText, nSerialLen) &&
+                     !memcmp(&serialStats, &parallelStats,
+                             sizeof(ImportStats));
+        }
+    }
+
+    printf("%-8s %s (policy %d, %lu bytes exported)\n",
+           isSame ? "same" : "DIFFERS", filename, nPolicy,
+           (unsigned long)nSerialLen);
+
+    free(serialText);
+    free(parallelText);
+    remove(CHECK_SERIAL);
+    remove(CHECK_PARALLEL);
+    freeDictionary(&serial);
+    freeDictionary(&parallel);
+
+    return isSame;
+}
+
+/**
+ * @brief
+ *    Checks that a dictionary file is split into several parts, so the
+ *    generated files really cover the boundaries between parts.
+ *
+ * @param filename   The name of the dictionary file.
+ *
+ * @return
+ *    1   if the file is split into CHECK_CHUNKS parts or more.
+ *    0   if not.
+ */
+int
+checkSplit(char *filename)
+{
+    ImportChunk *chunks;
+    char *text;
+    size_t len = 0;
+    int nChunks = 0;
+
+    text = readCheckFile(filename, &len);
+    if (text != NULL)
+    {
+        chunks = splitImportChunks(text, len, &nChunks);
+        free(chunks);
+        free(text);
+    }
+
+    if (nChunks < CHECK_CHUNKS)
+        printf("DIFFERS  %s is only split into %d parts\n", filename,
+               nChunks);
+
+    return nChunks >= CHECK_CHUNKS;
+}
+
+int
+main(int argc,
+     char *argv[])
+{
+    char *files[2] = {CHECK_LF_FILE, CHECK_CRLF_FILE};
+    int policies[4] = {
+        IMPORT_ACCEPT_ALL, IMPORT_SKIP, IMPORT_MERGE, IMPORT_REPLACE
+    };
+    int i, j;
+    int isSame;
+
+    isSame = generateDictFile(CHECK_LF_FILE, "\n") &&
+             generateDictFile(CHECK_CRLF_FILE, "\r\n") &&
+             checkSplit(CHECK_LF_FILE) && checkSplit(CHECK_CRLF_FILE);
+
+    for (i = 0; i < 2 && isSame; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            isSame = checkImport(files[i], policies[j]) && isSame;
+        }
+    }
+
+    for (i = 1; i < argc; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            isSame = checkImport(argv[i], policies[j]) && isSame;
+        }
+    }
+
+    remove(CHECK_LF_FILE);
+    remove(CHECK_CRLF_FILE);
+
+    printf("%s\n", isSame ? "All imports match." : "Some imports differ!");
+
+    return isSame ? EXIT_SUCCESS : EXIT_FAILURE;
+}
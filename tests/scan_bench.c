@@ -0,0 +1,346 @@
+/**
+ * @file scan_bench.c
+ * @brief
+ *    Times how the words of a text are found without their symbols, in two
+ *    ways: the way the Translate Feature first did it (removeSymbols() and
+ *    strtok() on each line), and the way the translator does it now
+ *    (scanWord() on each word, which copies it without its symbols in the
+ *    same pass). Both ways must find the same words. The text being
+ *    translated is never converted to lowercase, so that is timed on its
+ *    own: a loop of tolower(), as lowercase() first did, against
+ *    foldCase(), which lowercase() now uses for dictionary input and word
+ *    lists.
+ *
+ *    The text is generated, so the timings can be compared between
+ *    machines and builds (e.g. with and without -mavx2). From the root of
+ *    the repository:
+ *        gcc -O2 -pthread -o scan_bench tests/scan_bench.c
+ *        ./scan_bench
+ */
+
+// the translator is built into the benchmark, without its own main()
+#define main translatorMain
+#include "../main.c"
+#undef main
+
+#define BENCH_SIZE   (32 * 1024 * 1024)
+#define BENCH_ROUNDS 3
+
+/**
+ * @brief
+ *    Returns the next number of a fixed sequence of pseudo-random numbers,
+ *    so that the generated text is the same on every machine.
+ *
+ * @param pSeed   The state of the sequence, which is updated.
+ * @param nMax    The amount of numbers to choose from.
+ *
+ * @return Returns a number from 0 to nMax - 1.
+ */
+int
+getRandom(unsigned int *pSeed,
+          int nMax)
+{
+    *pSeed = *pSeed * 1103515245u + 12345u;
+
+    return (int)((*pSeed >> 16) % (unsigned int)nMax);
+}
+
+/**
+ * @brief
+ *    Generates BENCH_SIZE characters of text, in lines of at most
+ *    MAX_TEXT_LEN characters (as the Translate Feature accepts) made of
+ *    words in mixed case, some of them with symbols around or inside them.
+ *
+ * @param pLen   The address where the amount of characters is stored.
+ *
+ * @return Returns the text, which must be freed by the caller.
+ */
+char *
+generateText(size_t *pLen)
+{
+    static char *words[] = {
+        "love", "Mahal", "gugma", "amor", "ai", "expensive", "gui", "mal",
+        "buah-buahan", "prutas", "good", "MORNING", "magandang", "Umaga",
+        "charger", "caricabatteri", "luchtaire", "a", "WATER", "tubig"
+    };
+    static char *symbols[] = {"", "", "", "", ",", ".", "!", "?", "..."};
+    char *text;
+    char strWord[STR30LEN];
+    unsigned int nSeed = 2022;
+    size_t len = 0, nLineStart = 0, nWordLen;
+
+    text = (char *)malloc(BENCH_SIZE);
+    if (text == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while (len + STR30LEN < BENCH_SIZE)
+    {
+        if (getRandom(&nSeed, 10) == 0)
+            sprintf(strWord, "%s%s", symbols[getRandom(&nSeed, 9)],
+                    words[getRandom(&nSeed, 20)]);
+        else
+            sprintf(strWord, "%s%s", words[getRandom(&nSeed, 20)],
+                    symbols[getRandom(&nSeed, 9)]);
+
+        // a line ends before it gets too long for the Translate Feature
+        nWordLen = strlen(strWord);
+        if (len > nLineStart &&
+            len - nLineStart + nWordLen + 1 > MAX_TEXT_LEN)
+        {
+            text[len - 1] = '\n';
+            nLineStart = len;
+        }
+
+        memcpy(&text[len], strWord, nWordLen);
+        len += nWordLen;
+        text[len++] = ' ';
+    }
+
+    text[len - 1] = '\n';
+    *pLen = len;
+
+    return text;
+}
+
+/**
+ * @brief
+ *    Removes the symbols (see isSymbol()) from a string, as the Translate
+ *    Feature did before scanWord().
+ *
+ * @param strText   The string where the text is stored.
+ */
+void
+oldRemoveSymbols(String150 strText)
+{
+    int i = 0; // iterates through the string
+    int j = 0; // how many non-symbol characters there are
+
+    while (strText[i] != '\0')
+    {
+        if (strText[i] != ',' && strText[i] != '.' && strText[i] != '!' &&
+            strText[i] != '?')
+        {
+            strText[j] = strText[i];
+            j++;
+        }
+
+        i++;
+    }
+
+    strText[j] = '\0';
+}
+
+/**
+ * @brief
+ *    Finds the words of a text the old way: each line is copied into a
+ *    String150, stripped of its symbols and split with strtok().
+ *
+ * @param text     The text (not null-terminated).
+ * @param len      The amount of characters in the text.
+ * @param pWords   The address where the amount of words is stored.
+ *
+ * @return Returns the hash of all the words found, in order.
+ */
+unsigned int
+scanOld(char *text,
+        size_t len,
+        int *pWords)
+{
+    String150 strText;
+    char *word, *lineEnd;
+    unsigned int hash = 2166136261u;
+    size_t i = 0, nLineLen;
+
+    *pWords = 0;
+    while (i < len)
+    {
+        lineEnd = (char *)memchr(&text[i], '\n', len - i);
+        nLineLen = lineEnd == NULL ? len - i : (size_t)(lineEnd - &text[i]);
+        memcpy(strText, &text[i], nLineLen);
+        strText[nLineLen] = '\0';
+
+        oldRemoveSymbols(strText);
+
+        word = strtok(strText, " ");
+        while (word != NULL)
+        {
+            hash = hashBytes(word, strlen(word), hash);
+            hash = hashBytes(" ", 1, hash);
+            (*pWords)++;
+            word = strtok(NULL, " ");
+        }
+
+        i += nLineLen + 1;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief
+ *    Finds the words of a text the new way: each word is found with
+ *    scanWord(), which copies it without its symbols as it goes.
+ *
+ * @param text     The text (not null-terminated).
+ * @param len      The amount of characters in the text.
+ * @param pWords   The address where the amount of words is stored.
+ *
+ * @return Returns the hash of all the words found, in order.
+ */
+unsigned int
+scanNew(char *text,
+        size_t len,
+        int *pWords)
+{
+    String150 strWord;
+    WordScan scan;
+    unsigned int hash = 2166136261u;
+    size_t i = 0;
+
+    *pWords = 0;
+    while (i < len)
+    {
+        if (text[i] == ' ' || text[i] == '\r' || text[i] == '\n')
+        {
+            i++;
+        }
+        else
+        {
+            i += scanWord(&text[i], len - i, strWord, MAX_TEXT_LEN, &scan);
+
+            // a word that is only made of symbols is skipped
+            if (scan.nClean > 0)
+            {
+                hash = hashBytes(strWord, scan.nClean, hash);
+                hash = hashBytes(" ", 1, hash);
+                (*pWords)++;
+            }
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @brief
+ *    Converts a text to lowercase one character at a time, as lowercase()
+ *    did before foldCase().
+ *
+ * @param text   The text (not null-terminated), which is lowercased.
+ * @param len    The amount of characters in the text.
+ */
+void
+foldOld(char *text,
+        size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        text[i] = tolower(text[i]);
+    }
+}
+
+/**
+ * @brief
+ *    Times a way of handling a text, as the best of BENCH_ROUNDS rounds on
+ *    a fresh copy of the text each time.
+ *
+ * @param text     The text.
+ * @param copy     Where the text is copied for each round.
+ * @param len      The amount of characters in the text.
+ * @param scan     The way of finding the words, or NULL.
+ * @param fold     The way of converting to lowercase, if scan is NULL.
+ * @param pHash    The address where the hash of the words found is stored
+ *                 (only if scan is not NULL).
+ * @param pWords   The address where the amount of words found is stored
+ *                 (only if scan is not NULL).
+ *
+ * @return Returns the time of the fastest round, in seconds.
+ */
+double
+timeRounds(char *text,
+           char *copy,
+           size_t len,
+           unsigned int (*scan)(char *, size_t, int *),
+           void (*fold)(char *, size_t),
+           unsigned int *pHash,
+           int *pWords)
+{
+    double dStart, dTime, dBest = 0;
+    int i;
+
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        memcpy(copy, text, len);
+        dStart = getSeconds();
+        if (scan != NULL)
+            *pHash = scan(copy, len, pWords);
+        else
+            fold(copy, len);
+        dTime = getSeconds() - dStart;
+        if (i == 0 || dTime < dBest)
+            dBest = dTime;
+    }
+
+    return dBest;
+}
+
+int
+main()
+{
+    char *text, *copy, *folded;
+    size_t len;
+    double dOld, dNew, dFoldOld, dFoldNew;
+    unsigned int nOldHash = 0, nNewHash = 0;
+    int nOldWords = 0, nNewWords = 0;
+    int isSame;
+
+    text = generateText(&len);
+    copy = (char *)malloc(len);
+    folded = (char *)malloc(len);
+    if (copy == NULL || folded == NULL)
+    {
+        printf("Out of memory! Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    dOld = timeRounds(text, copy, len, scanOld, NULL, &nOldHash, &nOldWords);
+    dNew = timeRounds(text, copy, len, scanNew, NULL, &nNewHash, &nNewWords);
+    dFoldOld = timeRounds(text, folded, len, NULL, foldOld, NULL, NULL);
+    dFoldNew = timeRounds(text, copy, len, NULL, foldCase, NULL, NULL);
+
+    printf("Text: %.1f MB, %d words (best of %d rounds)\n",
+           len / 1048576.0, nOldWords, BENCH_ROUNDS);
+    printf("Finding the words:\n");
+    printf("  removeSymbols/strtok: %.3f s (%.0f MB/s)\n", dOld,
+           len / 1048576.0 / dOld);
+    printf("  scanWord:             %.3f s (%.0f MB/s)\n", dNew,
+           len / 1048576.0 / dNew);
+    printf("  Speedup: %.2fx\n", dOld / dNew);
+    printf("Converting to lowercase:\n");
+    printf("  tolower() loop:       %.3f s (%.0f MB/s)\n", dFoldOld,
+           len / 1048576.0 / dFoldOld);
+    printf("  foldCase:             %.3f s (%.0f MB/s)\n", dFoldNew,
+           len / 1048576.0 / dFoldNew);
+    printf("  Speedup: %.2fx\n", dFoldOld / dFoldNew);
+
+    isSame = memcmp(copy, folded, len) == 0;
+
+    free(folded);
+    free(copy);
+    free(text);
+
+    if (nOldHash != nNewHash || nOldWords != nNewWords || !isSame)
+    {
+        printf("The two ways differ!\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Both ways find the same words and lowercase the same.\n");
+
+    return EXIT_SUCCESS;
+}